@@ -0,0 +1,87 @@
+/*
+    SPDX-FileCopyrightText: 2024-2026 KDE Community
+    SPDX-License-Identifier: LGPL-2.1-or-later
+*/
+
+// KapsuleClient::forCurrentThread() from QThreadPool workers.  The calls
+// work whether or not a daemon is running; without one they fail fast.
+
+#include <Kapsule/KapsuleClient>
+
+#include <QMutex>
+#include <QSet>
+#include <QTest>
+#include <QThread>
+#include <QThreadPool>
+
+#include <qcoro/qcorotask.h>
+
+#include <atomic>
+
+using namespace Kapsule;
+
+class ClientThreadTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void listFromPoolThreads();
+};
+
+void ClientThreadTest::listFromPoolThreads()
+{
+    constexpr int kThreads = 4;
+    constexpr int kTasks = 64;
+
+    QMutex mutex;
+    QSet<KapsuleClient *> clients;
+    std::atomic<int> destroyed = 0;
+    std::atomic<int> wrongThread = 0;
+    std::atomic<int> notReused = 0;
+
+    {
+        QThreadPool pool;
+        pool.setMaxThreadCount(kThreads);
+        // Keep the threads, and so their clients, until the pool goes
+        // away, so no client address can be reused by another thread.
+        pool.setExpiryTimeout(-1);
+
+        for (int i = 0; i < kTasks; ++i) {
+            pool.start([&] {
+                KapsuleClient *client = KapsuleClient::forCurrentThread();
+                if (client->thread() != QThread::currentThread()) {
+                    ++wrongThread;
+                }
+                {
+                    QMutexLocker lock(&mutex);
+                    if (!clients.contains(client)) {
+                        clients.insert(client);
+                        QObject::connect(client, &QObject::destroyed, [&destroyed] {
+                            ++destroyed;
+                        });
+                    }
+                }
+
+                const auto containers = QCoro::waitFor(client->listContainers());
+                Q_UNUSED(containers);
+
+                if (KapsuleClient::forCurrentThread() != client) {
+                    ++notReused;
+                }
+            });
+        }
+        QVERIFY(pool.waitForDone(60000));
+        QCOMPARE(destroyed.load(), 0);
+    }
+
+    // Destroying the pool finished its threads, and with them their clients
+    QCOMPARE(wrongThread.load(), 0);
+    QCOMPARE(notReused.load(), 0);
+    QVERIFY(!clients.isEmpty());
+    QVERIFY(clients.size() <= kThreads);
+    QCOMPARE(destroyed.load(), clients.size());
+}
+
+QTEST_GUILESS_MAIN(ClientThreadTest)
+
+#include "clientthreadtest.moc"
@@ -0,0 +1,201 @@
+/*
+    SPDX-FileCopyrightText: 2024-2026 KDE Community
+    SPDX-License-Identifier: LGPL-2.1-or-later
+*/
+
+// Compares decoding a container list in the (sssss) format of
+// ListContainers with the compact v2 format of ListContainersV2.
+//
+// The lists come from a peer-to-peer D-Bus connection, so the replies are
+// real wire messages, but only the decoding is timed.
+
+#include "kapsuledbustypes.h"
+
+#include <QDBusArgument>
+#include <QDBusConnection>
+#include <QDBusMessage>
+#include <QDBusMetaType>
+#include <QDBusPendingCall>
+#include <QDBusServer>
+#include <QDBusVirtualObject>
+#include <QMetaEnum>
+#include <QTest>
+#include <QTimeZone>
+
+using namespace Kapsule;
+
+namespace {
+
+constexpr int kContainerCount = 1000;
+const QString kPath = QStringLiteral("/org/kde/kapsule");
+const QString kInterface = QStringLiteral("org.kde.kapsule.Manager");
+
+Container::State stateOf(int i)
+{
+    return i % 3 == 0 ? Container::State::Running : Container::State::Stopped;
+}
+
+QDateTime createdOf(int i)
+{
+    return QDateTime(QDate(2026, 1, 1), QTime(0, 0), QTimeZone::UTC).addSecs(i * 60);
+}
+
+// Answers ListContainers and ListContainersV2 with the same containers.
+// Rows are written field by field, like the daemon sends them.
+class ContainerListObject : public QDBusVirtualObject
+{
+public:
+    QString introspect(const QString &) const override
+    {
+        return {};
+    }
+
+    bool handleMessage(const QDBusMessage &message, const QDBusConnection &connection) override
+    {
+        const bool v2 = message.member() == QLatin1String("ListContainersV2");
+        if (!v2 && message.member() != QLatin1String("ListContainers")) {
+            return false;
+        }
+
+        QDBusArgument list;
+        list.beginArray(v2 ? QMetaType::fromType<ContainerV2>() : QMetaType::fromType<Container>());
+        for (int i = 0; i < kContainerCount; ++i) {
+            const QString name = QStringLiteral("container-%1").arg(i);
+            const QString image = QStringLiteral("images:archlinux");
+            const Container::State state = stateOf(i);
+            const QDateTime created = createdOf(i);
+
+            list.beginStructure();
+            if (v2) {
+                QVariantMap extra;
+                if (state == Container::State::Running) {
+                    extra.insert(QStringLiteral("started_at"), created.addSecs(30).toSecsSinceEpoch());
+                    extra.insert(QStringLiteral("pid"), qint64(10000 + i));
+                }
+                list << name << static_cast<int>(state) << image << created.toSecsSinceEpoch()
+                     << static_cast<int>(ContainerMode::Default) << extra;
+            } else {
+                list << name
+                     << QString::fromLatin1(QMetaEnum::fromType<Container::State>().valueToKey(static_cast<int>(state)))
+                     << image << created.toString(Qt::ISODate) << containerModeToString(ContainerMode::Default);
+            }
+            list.endStructure();
+        }
+        list.endArray();
+
+        return connection.send(message.createReply(QVariant::fromValue(list)));
+    }
+};
+
+} // namespace
+
+class ContainerDecodingBenchmark : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void cleanupTestCase();
+    void formatsDecodeAlike();
+    void decodeV1();
+    void decodeV2();
+
+private:
+    static QList<Container> decode(const QDBusMessage &reply, QMetaType listType);
+
+    ContainerListObject m_object;
+    QDBusServer *m_server = nullptr;
+    QDBusMessage m_v1Reply;
+    QDBusMessage m_v2Reply;
+};
+
+void ContainerDecodingBenchmark::initTestCase()
+{
+    registerDBusTypes();
+
+    m_server = new QDBusServer(this);
+    QVERIFY(m_server->isConnected());
+    connect(m_server, &QDBusServer::newConnection, this, [this](const QDBusConnection &connection) {
+        QDBusConnection(connection).registerVirtualObject(kPath, &m_object);
+    });
+
+    QDBusConnection client = QDBusConnection::connectToPeer(m_server->address(), QStringLiteral("bench"));
+    QVERIFY(client.isConnected());
+
+    QDBusPendingCall v1 = client.asyncCall(
+        QDBusMessage::createMethodCall(QString(), kPath, kInterface, QStringLiteral("ListContainers")));
+    QDBusPendingCall v2 = client.asyncCall(
+        QDBusMessage::createMethodCall(QString(), kPath, kInterface, QStringLiteral("ListContainersV2")));
+    QTRY_VERIFY(v1.isFinished() && v2.isFinished());
+    QVERIFY2(!v1.isError(), qPrintable(v1.error().message()));
+    QVERIFY2(!v2.isError(), qPrintable(v2.error().message()));
+    m_v1Reply = v1.reply();
+    m_v2Reply = v2.reply();
+}
+
+void ContainerDecodingBenchmark::cleanupTestCase()
+{
+    QDBusConnection::disconnectFromPeer(QStringLiteral("bench"));
+}
+
+// Both formats go through the metatype system, the way QDBusReply
+// decodes them in KapsuleClient.
+QList<Container> ContainerDecodingBenchmark::decode(const QDBusMessage &reply, QMetaType listType)
+{
+    // Reading detaches the argument, so every decode starts at the top.
+    const auto arg = reply.arguments().value(0).value<QDBusArgument>();
+    if (listType == QMetaType::fromType<QList<ContainerV2>>()) {
+        QList<ContainerV2> rows;
+        QDBusMetaType::demarshall(arg, listType, &rows);
+        QList<Container> containers;
+        containers.reserve(rows.size());
+        for (const ContainerV2 &row : std::as_const(rows)) {
+            containers.append(row.container);
+        }
+        return containers;
+    }
+
+    QList<Container> containers;
+    QDBusMetaType::demarshall(arg, listType, &containers);
+    return containers;
+}
+
+void ContainerDecodingBenchmark::formatsDecodeAlike()
+{
+    const QList<Container> v1 = decode(m_v1Reply, QMetaType::fromType<QList<Container>>());
+    const QList<Container> v2 = decode(m_v2Reply, QMetaType::fromType<QList<ContainerV2>>());
+    QCOMPARE(v1.size(), kContainerCount);
+    QCOMPARE(v2.size(), kContainerCount);
+
+    for (int i = 0; i < kContainerCount; ++i) {
+        QCOMPARE(v1[i].name(), v2[i].name());
+        QCOMPARE(v1[i].state(), stateOf(i));
+        QCOMPARE(v2[i].state(), stateOf(i));
+        QCOMPARE(v1[i].image(), v2[i].image());
+        QCOMPARE(v1[i].mode(), v2[i].mode());
+        QCOMPARE(v1[i].created(), createdOf(i));
+        QCOMPARE(v2[i].created(), createdOf(i));
+    }
+}
+
+void ContainerDecodingBenchmark::decodeV1()
+{
+    QList<Container> containers;
+    QBENCHMARK {
+        containers = decode(m_v1Reply, QMetaType::fromType<QList<Container>>());
+    }
+    QCOMPARE(containers.size(), kContainerCount);
+}
+
+void ContainerDecodingBenchmark::decodeV2()
+{
+    QList<Container> containers;
+    QBENCHMARK {
+        containers = decode(m_v2Reply, QMetaType::fromType<QList<ContainerV2>>());
+    }
+    QCOMPARE(containers.size(), kContainerCount);
+}
+
+QTEST_GUILESS_MAIN(ContainerDecodingBenchmark)
+
+#include "containerdecodingbenchmark.moc"
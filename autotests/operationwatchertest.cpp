@@ -0,0 +1,174 @@
+/*
+    SPDX-FileCopyrightText: 2024-2026 KDE Community
+    SPDX-License-Identifier: LGPL-2.1-or-later
+*/
+
+// Waits for many operations on one OperationWatcher, the way a single
+// client runs a batch: one signal subscription, dispatched by path.
+//
+// A second connection on the session bus plays the daemon.  It owns
+// org.kde.kapsule, answers the status queries and sends each operation's
+// signals to the watcher's connection only, like the real daemon does for
+// the requester.
+
+#include "operationwatcher.h"
+
+#include <QDBusConnection>
+#include <QDBusMessage>
+#include <QDBusVirtualObject>
+#include <QHash>
+#include <QLoggingCategory>
+#include <QTest>
+
+#include <qcoro/qcorotask.h>
+
+#include <atomic>
+
+// The library's logging category isn't exported.
+Q_LOGGING_CATEGORY(KAPSULE_LOG, "org.kde.kapsule")
+
+using namespace Kapsule;
+
+namespace {
+
+constexpr int kOperations = 100;
+const QString kService = QStringLiteral("org.kde.kapsule");
+const QString kOperationsPath = QStringLiteral("/org/kde/kapsule/operations");
+const QString kOperationInterface = QStringLiteral("org.kde.kapsule.Operation");
+const QString kDaemonConnection = QStringLiteral("fake-kapsule-daemon");
+
+QString operationPath(int i)
+{
+    return kOperationsPath + QLatin1Char('/') + QString::number(i);
+}
+
+// Every operation is still running when the watcher asks.  Virtual
+// objects are called on the connection's thread, hence the atomic.
+class RunningOperations : public QDBusVirtualObject
+{
+public:
+    QString introspect(const QString &) const override
+    {
+        return {};
+    }
+
+    bool handleMessage(const QDBusMessage &message, const QDBusConnection &connection) override
+    {
+        if (message.member() != QLatin1String("GetAll")) {
+            return false;
+        }
+        ++statusQueries;
+        const QVariantMap properties{
+            {QStringLiteral("Status"), QStringLiteral("running")},
+            {QStringLiteral("ErrorMessage"), QString()},
+        };
+        return connection.send(message.createReply(QVariant::fromValue(properties)));
+    }
+
+    std::atomic<int> statusQueries = 0;
+};
+
+} // namespace
+
+class OperationWatcherTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void cleanupTestCase();
+    void dispatchesManyOperationsByPath();
+
+private:
+    void sendSignal(const QDBusConnection &daemon, const QString &destination, int op,
+                    const QString &member, const QVariantList &args);
+
+    RunningOperations m_operations;
+};
+
+void OperationWatcherTest::initTestCase()
+{
+    if (!QDBusConnection::sessionBus().isConnected()) {
+        QSKIP("No D-Bus session bus");
+    }
+
+    QDBusConnection daemon = QDBusConnection::connectToBus(QDBusConnection::SessionBus, kDaemonConnection);
+    QVERIFY(daemon.isConnected());
+    if (!daemon.registerService(kService)) {
+        QSKIP("org.kde.kapsule is already owned on the session bus");
+    }
+    QVERIFY(daemon.registerVirtualObject(kOperationsPath, &m_operations, QDBusConnection::SubPath));
+}
+
+void OperationWatcherTest::cleanupTestCase()
+{
+    QDBusConnection::disconnectFromBus(kDaemonConnection);
+}
+
+void OperationWatcherTest::sendSignal(const QDBusConnection &daemon, const QString &destination, int op,
+                                      const QString &member, const QVariantList &args)
+{
+    QDBusMessage signal = QDBusMessage::createTargetedSignal(destination, operationPath(op),
+                                                             kOperationInterface, member);
+    signal.setArguments(args);
+    QVERIFY(daemon.send(signal));
+}
+
+void OperationWatcherTest::dispatchesManyOperationsByPath()
+{
+    const QDBusConnection client = QDBusConnection::sessionBus();
+    const QDBusConnection daemon = QDBusConnection(kDaemonConnection);
+    OperationWatcher watcher(client);
+
+    QHash<QString, QStringList> messages;
+    QHash<QString, int> progress;
+    QHash<QString, OperationResult> results;
+
+    for (int i = 0; i < kOperations; ++i) {
+        const QString path = operationPath(i);
+        OperationCallbacks callbacks;
+        callbacks.onMessage = [&messages, path](MessageType, const QString &text, int) {
+            messages[path].append(text);
+        };
+        callbacks.onProgressUpdate = [&progress, path](const QString &, int current, double) {
+            progress[path] = current;
+        };
+        QCoro::connect(watcher.watch(path, callbacks), this, [&results, path](const OperationResult &result) {
+            results.insert(path, result);
+        });
+    }
+    QVERIFY(watcher.hasWaiters());
+    QTRY_COMPARE(m_operations.statusQueries.load(), kOperations);
+    QVERIFY(results.isEmpty());
+
+    // Interleave the operations' signals, finishing them in reverse order
+    const QString destination = client.baseService();
+    for (int i = 0; i < kOperations; ++i) {
+        sendSignal(daemon, destination, i, QStringLiteral("Message"),
+                   {0, QStringLiteral("message for %1").arg(i), 0});
+    }
+    for (int i = 0; i < kOperations; ++i) {
+        sendSignal(daemon, destination, i, QStringLiteral("ProgressUpdate"),
+                   {QStringLiteral("bar"), i * 10, 0.0});
+    }
+    for (int i = kOperations - 1; i >= 0; --i) {
+        const bool success = i % 2 == 0;
+        sendSignal(daemon, destination, i, QStringLiteral("Completed"),
+                   {success, success ? QString() : QStringLiteral("failed %1").arg(i)});
+    }
+
+    QTRY_COMPARE(results.size(), kOperations);
+    QVERIFY(!watcher.hasWaiters());
+
+    for (int i = 0; i < kOperations; ++i) {
+        const QString path = operationPath(i);
+        QCOMPARE(messages.value(path), QStringList{QStringLiteral("message for %1").arg(i)});
+        QCOMPARE(progress.value(path, -1), i * 10);
+        QCOMPARE(results.value(path).success, i % 2 == 0);
+        QCOMPARE(results.value(path).error, i % 2 == 0 ? QString() : QStringLiteral("failed %1").arg(i));
+    }
+}
+
+QTEST_GUILESS_MAIN(OperationWatcherTest)
+
+#include "operationwatchertest.moc"
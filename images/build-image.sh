@@ -25,24 +25,63 @@ OUTPUT_BASE="$1"
 echo "Building all images with mkosi ..."
 mkosi --directory="$SCRIPT_DIR" build
 
-# Package each image output into Incus artifacts
+# Package each image output into Incus artifacts.  Images are packaged
+# in parallel; mksquashfs would otherwise grab every CPU for each image
+# in turn, so the CPUs are split between the concurrent jobs instead.
+images=()
 for image_dir in "$SCRIPT_DIR"/mkosi.images/*/; do
     [ -d "$image_dir" ] || continue
     image_name=$(basename "$image_dir")
-    rootfs_dir="$SCRIPT_DIR/mkosi.output/$image_name"
 
-    if [ ! -d "$rootfs_dir" ]; then
-        echo "Warning: no output for $image_name at $rootfs_dir, skipping" >&2
+    if [ ! -d "$SCRIPT_DIR/mkosi.output/$image_name" ]; then
+        echo "Warning: no output for $image_name at $SCRIPT_DIR/mkosi.output/$image_name, skipping" >&2
         continue
     fi
+    images+=("$image_name")
+done
+
+JOBS="${PACKAGE_JOBS:-${#images[@]}}"
+[ "$JOBS" -ge 1 ] || JOBS=1
+CPUS=$(nproc)
+MKSQUASHFS_PROCESSORS=$(( CPUS / JOBS ))
+[ "$MKSQUASHFS_PROCESSORS" -ge 1 ] || MKSQUASHFS_PROCESSORS=1
+export MKSQUASHFS_PROCESSORS
+
+package_image() {
+    local image_name="$1"
+    local rootfs_dir="$SCRIPT_DIR/mkosi.output/$image_name"
 
     # Pass the kapsule.yaml for this image (if it exists) so that
     # package-incus.sh can embed description and default_options into
     # the Incus image metadata properties.
-    kapsule_yaml="$SCRIPT_DIR/$image_name/kapsule.yaml"
+    local kapsule_yaml="$SCRIPT_DIR/$image_name/kapsule.yaml"
 
-    echo "Packaging $image_name for Incus ..."
-    "$SCRIPT_DIR/package-incus.sh" "$rootfs_dir" "$OUTPUT_BASE/$image_name" "$kapsule_yaml"
+    "$SCRIPT_DIR/package-incus.sh" "$rootfs_dir" "$OUTPUT_BASE/$image_name" "$kapsule_yaml" \
+        2>&1 | sed -u "s/^/[$image_name] /"
+}
+
+declare -A pids=()
+for image_name in "${images[@]}"; do
+    # Throttle to $JOBS concurrent packaging jobs
+    while [ "$(jobs -rp | wc -l)" -ge "$JOBS" ]; do
+        wait -n || true
+    done
+
+    echo "Packaging $image_name for Incus ($MKSQUASHFS_PROCESSORS CPUs) ..."
+    package_image "$image_name" &
+    pids[$image_name]=$!
 done
 
+failed=()
+for image_name in "${!pids[@]}"; do
+    if ! wait "${pids[$image_name]}"; then
+        failed+=("$image_name")
+    fi
+done
+
+if [ ${#failed[@]} -gt 0 ]; then
+    echo "Error: packaging failed for: ${failed[*]}" >&2
+    exit 1
+fi
+
 echo "All images built and packaged."
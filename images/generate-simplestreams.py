@@ -7,33 +7,147 @@
 
 import hashlib
 import json
+import mmap
 import os
 import sys
 from datetime import datetime, timezone
 from pathlib import Path
+from typing import Protocol
 
 import yaml
 
+# The chunker is shared with the daemon, which chunks cached images
+# itself and must cut them at the same offsets.
+sys.path.insert(0, str(Path(__file__).resolve().parent.parent / "src" / "daemon"))
+from cdc import CHUNK_INDEX_VERSION, chunk_boundaries  # noqa: E402
+
+# Read artifacts in large blocks; 8 KiB reads spend more time in Python
+# than in sha256 for multi-GB squashfs images.
+HASH_BUFFER_SIZE = 4 * 1024 * 1024
+
+HASH_CACHE_NAME = ".hash-cache.json"
+
+# The build machine has memory to spare, so chunk in larger numpy passes
+# than the daemon does.
+GENERATOR_HASH_BLOCK_SIZE = 16 * 1024 * 1024
+
+
+class _Hasher(Protocol):
+    def update(self, data: memoryview, /) -> None: ...
+
+
+def _hash_into(filepath: Path, *hashes: _Hasher) -> None:
+    buf = bytearray(HASH_BUFFER_SIZE)
+    view = memoryview(buf)
+    with open(filepath, "rb", buffering=0) as f:
+        while n := f.readinto(buf):
+            for h in hashes:
+                h.update(view[:n])
+
 
 def sha256sum(filepath: Path) -> str:
     h = hashlib.sha256()
-    with open(filepath, "rb") as f:
-        for chunk in iter(lambda: f.read(8192), b""):
-            h.update(chunk)
+    _hash_into(filepath, h)
     return h.hexdigest()
 
 
-def combined_sha256(meta_path: Path, rootfs_path: Path) -> str:
-    """Compute sha256(meta_content + rootfs_content).
+class HashCache:
+    """Artifact hashes keyed on (size, mtime), persisted between runs.
 
-    Incus uses this "combined" hash as the image fingerprint.
+    Nightly rebuilds often leave some images untouched; re-hashing
+    their multi-GB rootfs for nothing is the slowest part of this
+    script otherwise.
     """
-    h = hashlib.sha256()
-    for p in (meta_path, rootfs_path):
-        with open(p, "rb") as f:
-            for chunk in iter(lambda: f.read(8192), b""):
-                h.update(chunk)
-    return h.hexdigest()
+
+    def __init__(self, path: Path) -> None:
+        self._path = path
+        self._entries: dict[str, dict[str, object]] = {}
+        try:
+            with open(path) as f:
+                self._entries = json.load(f)
+        except (OSError, ValueError):
+            pass
+
+    @staticmethod
+    def _stamp(paths: tuple[Path, ...]) -> list[list[int]]:
+        return [[p.stat().st_size, p.stat().st_mtime_ns] for p in paths]
+
+    def get(self, paths: tuple[Path, ...]) -> list[str] | None:
+        entry = self._entries.get(str(paths[-1]))
+        if not entry or entry.get("stamp") != self._stamp(paths):
+            return None
+        hashes = entry.get("hashes")
+        return hashes if isinstance(hashes, list) else None
+
+    def put(self, paths: tuple[Path, ...], hashes: list[str]) -> None:
+        self._entries[str(paths[-1])] = {
+            "stamp": self._stamp(paths),
+            "hashes": hashes,
+        }
+
+    def save(self) -> None:
+        with open(self._path, "w") as f:
+            json.dump(self._entries, f, indent=1)
+
+
+def hash_split_image(
+    meta_path: Path, rootfs_path: Path, cache: HashCache
+) -> tuple[str, str, str]:
+    """Return (meta sha256, rootfs sha256, combined sha256) in one pass.
+
+    Incus uses the "combined" hash, sha256(meta_content + rootfs_content),
+    as the image fingerprint.  Each file is read once, feeding both its
+    own hash and the combined one.
+    """
+    paths = (meta_path, rootfs_path)
+    cached = cache.get(paths)
+    if cached and len(cached) == 3:
+        return cached[0], cached[1], cached[2]
+
+    combined = hashlib.sha256()
+    meta = hashlib.sha256()
+    rootfs = hashlib.sha256()
+    _hash_into(meta_path, meta, combined)
+    _hash_into(rootfs_path, rootfs, combined)
+    result = [meta.hexdigest(), rootfs.hexdigest(), combined.hexdigest()]
+    cache.put(paths, result)
+    return result[0], result[1], result[2]
+
+
+def write_chunk_index(rootfs: Path, index_path: Path, chunks_dir: Path) -> None:
+    """Split *rootfs* into content-addressed chunks and write its index.
+
+    Chunks are stored as ``<chunks_dir>/<sha[:2]>/<sha>``; existing chunk
+    files are left alone, so chunks shared between images are written
+    once.  The index lists the chunks in order together with the size
+    and sha256 of the reassembled file.
+    """
+    chunks: list[dict[str, object]] = []
+    whole = hashlib.sha256()
+    with open(rootfs, "rb") as f, mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ) as data:
+        size = len(data)
+        start = 0
+        for end in chunk_boundaries(data, block_size=GENERATOR_HASH_BLOCK_SIZE):
+            piece = data[start:end]
+            whole.update(piece)
+            digest = hashlib.sha256(piece).hexdigest()
+            chunk_path = chunks_dir / digest[:2] / digest
+            if not chunk_path.exists():
+                chunk_path.parent.mkdir(parents=True, exist_ok=True)
+                chunk_path.write_bytes(piece)
+            chunks.append({"sha256": digest, "size": end - start})
+            start = end
+
+    index = {
+        "version": CHUNK_INDEX_VERSION,
+        "size": size,
+        "sha256": whole.hexdigest(),
+        "chunk_path": "chunks",
+        "chunks": chunks,
+    }
+    with open(index_path, "w") as f:
+        json.dump(index, f, separators=(",", ":"))
+    print(f"Wrote {index_path} ({len(chunks)} chunks)")
 
 
 def load_kapsule_yaml(image_dir: Path) -> dict[str, object]:
@@ -73,6 +187,7 @@ def main() -> None:
 
     products: dict[str, dict[str, object]] = {}
     product_ids: list[str] = []
+    hash_cache = HashCache(out_dir / HASH_CACHE_NAME)
 
     # Discover images by looking for kapsule.yaml in subdirectories
     for image_name in sorted(os.listdir(images_dir)):
@@ -127,8 +242,15 @@ def main() -> None:
         incus_tar = image_out_dir / "incus.tar.xz"
         rootfs = image_out_dir / "rootfs.squashfs"
 
+        rootfs_sha: str | None = None
         if incus_tar.exists():
-            incus_sha = sha256sum(incus_tar)
+            combined: str | None = None
+            if rootfs.exists():
+                incus_sha, rootfs_sha, combined = hash_split_image(
+                    incus_tar, rootfs, hash_cache
+                )
+            else:
+                incus_sha = sha256sum(incus_tar)
             incus_size = incus_tar.stat().st_size
             incus_item: dict[str, object] = {
                 "ftype": "incus.tar.xz",
@@ -138,8 +260,7 @@ def main() -> None:
             }
 
             # Incus uses combined_*_sha256 as the image fingerprint.
-            if rootfs.exists():
-                combined = combined_sha256(incus_tar, rootfs)
+            if combined:
                 incus_item["combined_squashfs_sha256"] = combined
 
             items["incus.tar.xz"] = incus_item
@@ -152,11 +273,28 @@ def main() -> None:
         if rootfs.exists():
             items["root.squashfs"] = {
                 "ftype": "squashfs",
-                "sha256": sha256sum(rootfs),
+                "sha256": rootfs_sha or sha256sum(rootfs),
                 "size": rootfs.stat().st_size,
                 "path": image_path("rootfs.squashfs"),
             }
 
+            # The chunk store lives next to images/ on the server root,
+            # which only exists with the S3 layout, not with artifact
+            # redirects.  Incus ignores item types it doesn't know.
+            if not artifacts_base_url:
+                chunk_index = image_out_dir / "rootfs.chunks.json"
+                if (
+                    not chunk_index.exists()
+                    or chunk_index.stat().st_mtime_ns < rootfs.stat().st_mtime_ns
+                ):
+                    write_chunk_index(rootfs, chunk_index, out_dir / "chunks")
+                items["root.squashfs.chunks"] = {
+                    "ftype": "kapsule.chunks",
+                    "sha256": sha256sum(chunk_index),
+                    "size": chunk_index.stat().st_size,
+                    "path": image_path("rootfs.chunks.json"),
+                }
+
         product_entry: dict[str, object] = {
             "aliases": aliases,
             "arch": arch,
@@ -187,6 +325,8 @@ def main() -> None:
 
         products[product_id] = product_entry
 
+    hash_cache.save()
+
     # Generate index.json
     index = {
         "format": "index:1.0",
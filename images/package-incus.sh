@@ -56,11 +56,16 @@ if [ -n "$KAPSULE_YAML" ] && [ -f "$KAPSULE_YAML" ]; then
 fi
 python3 "$SCRIPT_DIR/generate-metadata.py" "${generate_args[@]}"
 
-tar -cf - -C "$METADATA_DIR" metadata.yaml | xz -T0 > "$OUTPUT_DIR/incus.tar.xz"
+tar -cf - -C "$METADATA_DIR" metadata.yaml | xz -T"${MKSQUASHFS_PROCESSORS:-0}" > "$OUTPUT_DIR/incus.tar.xz"
 
 # --- Build rootfs squashfs ---
-mksquashfs "$ROOTFS_DIR" "$OUTPUT_DIR/rootfs.squashfs" \
-    -noappend -comp zstd -Xcompression-level 3
+# MKSQUASHFS_PROCESSORS limits the compressor threads when several
+# images are packaged in parallel (see build-image.sh).
+squashfs_args=(-noappend -comp zstd -Xcompression-level 3)
+if [ -n "${MKSQUASHFS_PROCESSORS:-}" ]; then
+    squashfs_args+=(-processors "$MKSQUASHFS_PROCESSORS")
+fi
+mksquashfs "$ROOTFS_DIR" "$OUTPUT_DIR/rootfs.squashfs" "${squashfs_args[@]}"
 
 # --- Write version ---
 echo "$VERSION" > "$OUTPUT_DIR/version"
@@ -90,14 +90,23 @@ cp streams/v1/index.json streams/v1/images.json upload-tree/streams/v1/
 # Copy image artifacts into paths matching what generate-simplestreams.py produced.
 # The generator uses: images/<name>/<arch>/<version>/<file>
 for image_out in out/*/; do
+    [ -f "${image_out}/incus.tar.xz" ] || continue
     image_name=$(basename "${image_out}")
     version=$(cat "${image_out}/version" 2>/dev/null || date +%Y%m%d)
     dest="upload-tree/images/${image_name}/amd64/${version}"
     mkdir -p "${dest}"
     cp "${image_out}/incus.tar.xz" "${dest}/"
     cp "${image_out}/rootfs.squashfs" "${dest}/"
+    if [ -f "${image_out}/rootfs.chunks.json" ]; then
+        cp "${image_out}/rootfs.chunks.json" "${dest}/"
+    fi
 done
 
+# Content-addressed rootfs chunks, shared by all images.
+if [ -d out/chunks ]; then
+    cp -r out/chunks upload-tree/
+fi
+
 # --- Upload ---
 
 echo "Uploading to kde/${S3_TARGET}/ ..."
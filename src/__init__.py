@@ -4,4 +4,4 @@
 
 """Kapsule - Container management with KDE integration."""
 
-__version__ = "0.2.1"
+__version__ = "0.3.0"
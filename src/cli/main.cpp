@@ -3,34 +3,50 @@
     SPDX-License-Identifier: GPL-3.0-or-later
 */
 
+#include "kapsule_version.h"
 #include "output.h"
 #include "rang.hpp"
 
 #include <Kapsule/KapsuleClient>
 #include <Kapsule/Container>
+#include <Kapsule/ContainerStats>
+#include <Kapsule/Image>
 #include <Kapsule/Types>
+#include <Kapsule/WhenAll>
 
 #include <QCommandLineOption>
 #include <QCommandLineParser>
 #include <QCoreApplication>
 #include <QDir>
 #include <QFileInfo>
+#include <QHash>
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QList>
+#include <QMetaEnum>
+#include <QRegularExpression>
+#include <QSet>
+#include <QSocketNotifier>
 
+#include <qcoro/qcoroasyncgenerator.h>
 #include <qcoro/qcorotask.h>
 #include <qcoro/qcorocore.h>
+#include <qcoro/qcorosignal.h>
 
+#include <fcntl.h>
 #include <unistd.h>
 #include <sys/wait.h>
+#include <algorithm>
 #include <cerrno>
+#include <chrono>
 #include <csignal>
 #include <cstring>
 #include <iomanip>
 #include <iostream>
 #include <memory>
+#include <optional>
+#include <sstream>
 
 using namespace Kapsule;
 
@@ -73,103 +89,270 @@ static void emitOsc777ContainerPop()
 // Forward declarations for command handlers
 QCoro::Task<int> cmdCreate(KapsuleClient &client, const QStringList &args);
 
-/**
- * @brief Create OperationCallbacks that display messages and progress bars.
- */
-static OperationCallbacks makeOutputCallbacks(Output &o)
+// =============================================================================
+// Ctrl-C handling
+// =============================================================================
+
+// Object path of the daemon operation we are currently waiting on, cleared
+// once its result is in so a later Ctrl-C doesn't cancel a finished one.
+static QString currentOperation;
+
+// Self-pipe: the signal handler only writes a byte, the event loop does the rest.
+static int interruptPipe[2] = {-1, -1};
+
+static void handleInterrupt(int)
 {
-    // Shared state for active progress bars (owned by the returned callbacks via shared_ptr)
-    struct State {
-        struct ActiveBar {
-            QString progressId;
-            std::string description;
-            int total = -1;
-            int extraIndent = 0;
-            std::string lastText;  // Raw text from daemon (e.g. Incus download_progress)
-        };
-        // Keep a small ordered list rather than a map because we only expect
-        // at most one active progress bar in normal use, with rare overlap.
-        QList<ActiveBar> activeBars;
+    const char byte = 1;
+    [[maybe_unused]] const auto written = ::write(interruptPipe[1], &byte, 1);
+}
+
+static void interruptNow()
+{
+    std::signal(SIGINT, SIG_DFL);
+    std::raise(SIGINT);
+}
+
+// The first Ctrl-C asks the daemon to cancel the running operation (and
+// with it any Incus download), so the command can report the failure and
+// exit cleanly.  A second Ctrl-C, or one with nothing to cancel, exits
+// immediately as before.
+static void installInterruptHandler(KapsuleClient &client)
+{
+    if (::pipe2(interruptPipe, O_CLOEXEC | O_NONBLOCK) != 0) {
+        return;
+    }
+
+    struct sigaction action {};
+    action.sa_handler = handleInterrupt;
+    sigemptyset(&action.sa_mask);
+    action.sa_flags = SA_RESTART;
+    sigaction(SIGINT, &action, nullptr);
+
+    auto *notifier = new QSocketNotifier(interruptPipe[0], QSocketNotifier::Read, &client);
+    QObject::connect(notifier, &QSocketNotifier::activated, &client, [&client]() {
+        char buffer[16];
+        while (::read(interruptPipe[0], buffer, sizeof(buffer)) > 0) {
+        }
+
+        static bool cancelling = false;
+        if (cancelling || currentOperation.isEmpty()) {
+            interruptNow();
+            return;
+        }
+        cancelling = true;
+
+        out().warning("Cancelling... (press Ctrl-C again to quit)");
+        QCoro::connect(client.cancelOperation(currentOperation), &client, [](bool cancelled) {
+            if (!cancelled) {
+                // Already finished or unreachable: nothing to wait for
+                interruptNow();
+            }
+        });
+    });
+}
+
+// =============================================================================
+// Machine-readable output (--output json|ndjson)
+// =============================================================================
+
+enum class OutputFormat {
+    Text,
+    Json,   // One JSON document per command
+    Ndjson, // One JSON object per line, streamed as things happen
+};
+
+static OutputFormat outputFormat = OutputFormat::Text;
+
+// Events of the running operation, printed together with its result
+// in json mode.
+static QJsonArray operationEvents;
+
+static bool jsonOutput()
+{
+    return outputFormat != OutputFormat::Text;
+}
+
+// Write one compact JSON document on its own line to stdout.
+static void printJson(const QJsonValue &value)
+{
+    const QByteArray json = value.isArray()
+        ? QJsonDocument(value.toArray()).toJson(QJsonDocument::Compact)
+        : QJsonDocument(value.toObject()).toJson(QJsonDocument::Compact);
+    std::cout << json.constData() << '\n' << std::flush;
+}
+
+// Print a list as one array (json) or one element per line (ndjson).
+static void printJsonList(const QJsonArray &items)
+{
+    if (outputFormat == OutputFormat::Json) {
+        printJson(items);
+        return;
+    }
+    for (const QJsonValue &item : items) {
+        printJson(item);
+    }
+}
+
+static QJsonValue jsonTime(const QDateTime &time)
+{
+    return time.isValid() ? QJsonValue(time.toUTC().toString(Qt::ISODateWithMs)) : QJsonValue();
+}
+
+static QJsonObject containerToJson(const Container &c)
+{
+    return {
+        {QStringLiteral("name"), c.name()},
+        {QStringLiteral("state"), QString::fromLatin1(QMetaEnum::fromType<Container::State>().valueToKey(static_cast<int>(c.state())))},
+        {QStringLiteral("image"), c.image()},
+        {QStringLiteral("mode"), containerModeToString(c.mode())},
+        {QStringLiteral("created"), jsonTime(c.created())},
+        {QStringLiteral("startedAt"), jsonTime(c.startedAt())},
+        {QStringLiteral("pid"), c.pid() ? QJsonValue(c.pid()) : QJsonValue()},
+    };
+}
+
+static QJsonObject imageToJson(const Image &img)
+{
+    return {
+        {QStringLiteral("fingerprint"), img.fingerprint()},
+        {QStringLiteral("aliases"), QJsonArray::fromStringList(img.aliases())},
+        {QStringLiteral("description"), img.description()},
+        {QStringLiteral("size"), img.size()},
+        {QStringLiteral("uploaded"), jsonTime(img.uploaded())},
     };
-    auto state = std::make_shared<State>();
+}
+
+// Print (ndjson) or collect (json) one operation event.
+static void operationEvent(const QString &event, QJsonObject fields)
+{
+    fields.insert(QStringLiteral("time"), jsonTime(QDateTime::currentDateTimeUtc()));
+    fields.insert(QStringLiteral("event"), event);
+    if (outputFormat == OutputFormat::Ndjson) {
+        printJson(fields);
+    } else {
+        operationEvents.append(fields);
+    }
+}
 
-    const auto findBar = [state](const QString &id) {
-        return std::find_if(state->activeBars.begin(), state->activeBars.end(), [&id](const State::ActiveBar &bar) {
-            return bar.progressId == id;
+static OperationCallbacks makeJsonCallbacks()
+{
+    operationEvents = QJsonArray();
+
+    OperationCallbacks cb;
+    cb.onStarted = [](const QString &objectPath) {
+        currentOperation = objectPath;
+        operationEvent(QStringLiteral("started"), {{QStringLiteral("operation"), objectPath}});
+    };
+    cb.onMessage = [](MessageType type, const QString &msg, int indent) {
+        operationEvent(QStringLiteral("message"), {
+            {QStringLiteral("type"), QString::fromLatin1(QMetaEnum::fromType<MessageType>().valueToKey(static_cast<int>(type))).toLower()},
+            {QStringLiteral("message"), msg},
+            {QStringLiteral("indent"), indent},
+        });
+    };
+    cb.onProgressStart = [](const QString &id, const QString &desc, int total, int indent) {
+        operationEvent(QStringLiteral("progress-started"), {
+            {QStringLiteral("id"), id},
+            {QStringLiteral("description"), desc},
+            {QStringLiteral("total"), total},
+            {QStringLiteral("indent"), indent},
+        });
+    };
+    cb.onProgressUpdate = [](const QString &id, int current, double rate) {
+        operationEvent(QStringLiteral("progress"), {
+            {QStringLiteral("id"), id},
+            {QStringLiteral("current"), current},
+            {QStringLiteral("rate"), rate},
+        });
+    };
+    cb.onProgressTextUpdate = [](const QString &id, const QString &text) {
+        operationEvent(QStringLiteral("progress-text"), {
+            {QStringLiteral("id"), id},
+            {QStringLiteral("text"), text},
         });
     };
+    cb.onProgressComplete = [](const QString &id, bool success, const QString &msg) {
+        operationEvent(QStringLiteral("progress-completed"), {
+            {QStringLiteral("id"), id},
+            {QStringLiteral("success"), success},
+            {QStringLiteral("message"), msg},
+        });
+    };
+    return cb;
+}
+
+/**
+ * @brief Create OperationCallbacks that display messages and progress bars.
+ */
+static OperationCallbacks makeOutputCallbacks(Output &o)
+{
+    if (jsonOutput()) {
+        return makeJsonCallbacks();
+    }
 
+    // Output keeps the live bars and draws them all at once
     OperationCallbacks cb;
+    cb.onStarted = [](const QString &objectPath) {
+        currentOperation = objectPath;
+    };
     cb.onMessage = [&o](MessageType type, const QString &msg, int indent) {
         o.print(type, msg.toStdString(), indent);
     };
-    cb.onProgressStart = [&o, state, findBar](const QString &id, const QString &desc, int total, int indent) {
-        if (auto it = findBar(id); it != state->activeBars.end()) {
-            *it = {id, desc.toStdString(), total, indent, {}};
-        } else {
-            state->activeBars.append({id, desc.toStdString(), total, indent, {}});
-        }
-        if (!state->activeBars.isEmpty() && state->activeBars.first().progressId == id) {
-            IndentGuard guard(o, indent * 2);
-            o.progress(desc.toStdString(), 0, total);
-        }
+    cb.onProgressStart = [&o](const QString &id, const QString &desc, int total, int indent) {
+        IndentGuard guard(o, indent * 2);
+        o.startProgress(id.toStdString(), desc.toStdString(), total);
     };
-    cb.onProgressUpdate = [&o, state, findBar](const QString &id, int current, double /*rate*/) {
-        if (state->activeBars.isEmpty() || state->activeBars.first().progressId != id) {
-            return;
-        }
-        if (auto it = findBar(id); it != state->activeBars.end()) {
-            auto &bar = *it;
-            IndentGuard guard(o, bar.extraIndent * 2);
-            // For indeterminate bars with raw text, show the text instead of description
-            if (bar.total < 0 && !bar.lastText.empty()) {
-                o.progress(bar.lastText, current, bar.total);
-            } else {
-                o.progress(bar.description, current, bar.total);
-            }
-        }
+    cb.onProgressUpdate = [&o](const QString &id, int current, double rate) {
+        o.updateProgress(id.toStdString(), current, rate);
     };
-    cb.onProgressTextUpdate = [state, findBar](const QString &id, const QString &text) {
-        if (auto it = findBar(id); it != state->activeBars.end()) {
-            it->lastText = text.toStdString();
-        }
+    cb.onProgressTextUpdate = [&o](const QString &id, const QString &text) {
+        o.setProgressText(id.toStdString(), text.toStdString());
     };
-    cb.onProgressComplete = [&o, state, findBar](const QString &id, bool /*success*/, const QString &msg) {
-        const bool wasVisible = (!state->activeBars.isEmpty() && state->activeBars.first().progressId == id);
-        int extraIndent = 0;
-        if (auto it = findBar(id); it != state->activeBars.end()) {
-            extraIndent = it->extraIndent;
-            state->activeBars.erase(it);
-        }
-
-        if (!wasVisible) {
-            return;
-        }
-
-        if (state->activeBars.isEmpty()) {
-            IndentGuard guard(o, extraIndent * 2);
-            if (!msg.isEmpty()) {
-                o.progressComplete(msg.toStdString());
-            } else {
-                o.progressComplete();
-            }
-            return;
-        }
-
-        {
-            IndentGuard guard(o, extraIndent * 2);
-            o.progressComplete();
-        }
-        const auto &nextBar = state->activeBars.first();
-        IndentGuard nextGuard(o, nextBar.extraIndent * 2);
-        if (nextBar.total < 0 && !nextBar.lastText.empty()) {
-            o.progress(nextBar.lastText, 0, nextBar.total);
-        } else {
-            o.progress(nextBar.description, 0, nextBar.total);
-        }
+    cb.onProgressComplete = [&o](const QString &id, bool /*success*/, const QString &msg) {
+        o.completeProgress(id.toStdString(), msg.toStdString());
     };
     return cb;
 }
+
+// Report how an operation ended and return the command's exit status.
+// successMessage may be empty for commands that print their own summary.
+static int reportOperation(Output &o, const OperationResult &result, std::string_view successMessage)
+{
+    if (outputFormat == OutputFormat::Ndjson) {
+        operationEvent(QStringLiteral("completed"), {
+            {QStringLiteral("success"), result.success},
+            {QStringLiteral("error"), result.error},
+        });
+    } else if (outputFormat == OutputFormat::Json) {
+        printJson(QJsonObject{
+            {QStringLiteral("operation"), currentOperation},
+            {QStringLiteral("success"), result.success},
+            {QStringLiteral("error"), result.error},
+            {QStringLiteral("events"), operationEvents},
+        });
+    } else if (!result.success) {
+        o.failure(result.error.toStdString());
+    } else if (!successMessage.empty()) {
+        o.success(successMessage);
+    }
+    currentOperation.clear();
+    return result.success ? 0 : 1;
+}
+
+// Report an error that ends the command before any operation ran: as
+// text on stderr, plus an error object on stdout in json and ndjson mode
+// so scripts see why we failed.
+static void reportError(Output &o, std::string_view message)
+{
+    o.error(message);
+    if (jsonOutput()) {
+        printJson(QJsonObject{
+            {QStringLiteral("success"), false},
+            {QStringLiteral("error"), QString::fromUtf8(message.data(), static_cast<qsizetype>(message.size()))},
+        });
+    }
+}
+
 QCoro::Task<int> cmdEnter(KapsuleClient &client, const QStringList &args);
 QCoro::Task<int> cmdList(KapsuleClient &client, const QStringList &args);
 QCoro::Task<int> cmdStart(KapsuleClient &client, const QStringList &args);
@@ -180,11 +363,12 @@ QCoro::Task<int> cmdImage(KapsuleClient &client, const QStringList &args);
 QCoro::Task<int> cmdImageImport(KapsuleClient &client, const QStringList &args);
 QCoro::Task<int> cmdImageList(KapsuleClient &client, const QStringList &args);
 QCoro::Task<int> cmdImageDelete(KapsuleClient &client, const QStringList &args);
+QCoro::Task<int> cmdTop(KapsuleClient &client, const QStringList &args);
 
 void printUsage()
 {
     auto &o = out();
-    o.info(QStringLiteral("Usage: %1 <command> [options]").arg(programName).toStdString());
+    o.info(QStringLiteral("Usage: %1 [--output <format>] <command> [options]").arg(programName).toStdString());
     o.info("");
     o.section("Commands:");
     {
@@ -192,9 +376,10 @@ void printUsage()
         o.info("create <name>    Create a new container");
         o.info("enter [name]     Enter a container (default if configured)");;
         o.info("list             List containers");
-        o.info("start <name>     Start a stopped container");
-        o.info("stop <name>      Stop a running container");
-        o.info("rm <name>        Remove a container");
+        o.info("top              Show live resource usage of running containers");
+        o.info("start <name>...  Start stopped containers");
+        o.info("stop <name>...   Stop running containers");
+        o.info("rm <name>...     Remove containers");
         o.info("config           Show configuration");
         o.info("image import     Import a local image");
         o.info("image list       List imported images");
@@ -202,19 +387,116 @@ void printUsage()
         o.info("image refresh    Refresh cached images");
     }
     o.info("");
+    o.section("Options:");
+    {
+        IndentGuard g(o);
+        o.info("--output <format>  text (default), json or ndjson");
+    }
+    o.info("");
     o.dim(QStringLiteral("Run '%1 <command> --help' for command-specific help.").arg(programName).toStdString());
 }
 
+// Dump the client's call latencies to stderr (KAPSULE_STATS=1).
+void printStatistics(const KapsuleClient &client)
+{
+    if (!client.statisticsEnabled()) {
+        return;
+    }
+
+    const auto ms = [](std::chrono::microseconds us) {
+        std::ostringstream s;
+        s << std::fixed << std::setprecision(1) << us.count() / 1000.0 << "ms";
+        return s.str();
+    };
+    const auto table = [&ms](const char *title, const QMap<QString, LatencyHistogram> &histograms) {
+        if (histograms.isEmpty()) {
+            return;
+        }
+        std::cerr << title << '\n'
+                  << "  " << std::left << std::setw(24) << "method" << std::right
+                  << std::setw(6) << "count" << std::setw(10) << "mean"
+                  << std::setw(10) << "p50" << std::setw(10) << "p90"
+                  << std::setw(10) << "max" << '\n';
+        for (auto it = histograms.cbegin(); it != histograms.cend(); ++it) {
+            const LatencyHistogram &h = it.value();
+            std::cerr << "  " << std::left << std::setw(24) << it.key().toStdString() << std::right
+                      << std::setw(6) << h.count << std::setw(10) << ms(h.mean())
+                      << std::setw(10) << ms(h.quantile(0.5)) << std::setw(10) << ms(h.quantile(0.9))
+                      << std::setw(10) << ms(h.max) << '\n';
+        }
+    };
+
+    const ClientStatistics stats = client.statistics();
+    table("D-Bus calls:", stats.calls);
+    table("Operations, reply to first signal:", stats.operationFirstSignal);
+    table("Operations, reply to finish:", stats.operationTotal);
+}
+
+QCoro::Task<int> runCommand(KapsuleClient &client, const QString &command, const QStringList &cmdArgs)
+{
+    auto &o = out();
+
+    if (command == QStringLiteral("create")) {
+        co_return co_await cmdCreate(client, cmdArgs);
+    } else if (command == QStringLiteral("enter")) {
+        co_return co_await cmdEnter(client, cmdArgs);
+    } else if (command == QStringLiteral("list") || command == QStringLiteral("ls")) {
+        co_return co_await cmdList(client, cmdArgs);
+    } else if (command == QStringLiteral("start")) {
+        co_return co_await cmdStart(client, cmdArgs);
+    } else if (command == QStringLiteral("stop")) {
+        co_return co_await cmdStop(client, cmdArgs);
+    } else if (command == QStringLiteral("rm") || command == QStringLiteral("remove")) {
+        co_return co_await cmdRm(client, cmdArgs);
+    } else if (command == QStringLiteral("top")) {
+        co_return co_await cmdTop(client, cmdArgs);
+    } else if (command == QStringLiteral("config")) {
+        co_return co_await cmdConfig(client, cmdArgs);
+    } else if (command == QStringLiteral("image")) {
+        co_return co_await cmdImage(client, cmdArgs);
+    } else {
+        reportError(o, QStringLiteral("Unknown command: %1").arg(command).toStdString());
+        printUsage();
+        co_return 1;
+    }
+}
+
 QCoro::Task<int> asyncMain(const QStringList &args)
 {
     auto &o = out();
 
-    if (args.size() < 2) {
+    // Global options come before the command
+    QStringList rest = args.mid(1);
+    while (!rest.isEmpty()
+           && (rest.first() == QLatin1String("--output") || rest.first().startsWith(QLatin1String("--output=")))) {
+        const QString option = rest.takeFirst();
+        QString format;
+        if (option.startsWith(QLatin1String("--output="))) {
+            format = option.mid(9);
+        } else if (!rest.isEmpty()) {
+            format = rest.takeFirst();
+        }
+
+        if (format == QLatin1String("text")) {
+            outputFormat = OutputFormat::Text;
+        } else if (format == QLatin1String("json")) {
+            outputFormat = OutputFormat::Json;
+        } else if (format == QLatin1String("ndjson")) {
+            outputFormat = OutputFormat::Ndjson;
+        } else {
+            // Still json if an earlier --output asked for it
+            reportError(o, QStringLiteral("Unknown output format: '%1'").arg(format).toStdString());
+            o.hint("Use text, json or ndjson");
+            co_return 1;
+        }
+    }
+
+    if (rest.isEmpty()) {
         printUsage();
         co_return 0;
     }
 
-    QString command = args.at(1);
+    QString command = rest.first();
 
     // Handle --help and --version at top level
     if (command == QStringLiteral("--help") || command == QStringLiteral("-h")) {
@@ -231,36 +513,19 @@ QCoro::Task<int> asyncMain(const QStringList &args)
     KapsuleClient client;
 
     if (!client.isConnected()) {
-        o.error("Cannot connect to kapsule-daemon");
+        reportError(o, "Cannot connect to kapsule-daemon");
         o.hint("Is the daemon running? Try: systemctl status kapsule-daemon");
         co_return 1;
     }
 
+    installInterruptHandler(client);
+
     // Remaining args after command
-    QStringList cmdArgs = args.mid(2);
+    const QStringList cmdArgs = rest.mid(1);
 
-    // Dispatch to command handlers
-    if (command == QStringLiteral("create")) {
-        co_return co_await cmdCreate(client, cmdArgs);
-    } else if (command == QStringLiteral("enter")) {
-        co_return co_await cmdEnter(client, cmdArgs);
-    } else if (command == QStringLiteral("list") || command == QStringLiteral("ls")) {
-        co_return co_await cmdList(client, cmdArgs);
-    } else if (command == QStringLiteral("start")) {
-        co_return co_await cmdStart(client, cmdArgs);
-    } else if (command == QStringLiteral("stop")) {
-        co_return co_await cmdStop(client, cmdArgs);
-    } else if (command == QStringLiteral("rm") || command == QStringLiteral("remove")) {
-        co_return co_await cmdRm(client, cmdArgs);
-    } else if (command == QStringLiteral("config")) {
-        co_return co_await cmdConfig(client, cmdArgs);
-    } else if (command == QStringLiteral("image")) {
-        co_return co_await cmdImage(client, cmdArgs);
-    } else {
-        o.error(QStringLiteral("Unknown command: %1").arg(command).toStdString());
-        printUsage();
-        co_return 1;
-    }
+    const int status = co_await runCommand(client, command, cmdArgs);
+    printStatistics(client);
+    co_return status;
 }
 
 // =============================================================================
@@ -280,7 +545,7 @@ QCoro::Task<int> asyncMain(const QStringList &args)
 static QList<QCommandLineOption> schemaToCliOptions(const CreateSchema &schema)
 {
     QList<QCommandLineOption> cliOptions;
-    for (const auto &opt : schema.allOptions()) {
+    for (const auto &opt : schema.options()) {
         const QString flag = opt.cliFlag();
 
         if (opt.type == QStringLiteral("boolean")) {
@@ -323,38 +588,46 @@ static QList<QCommandLineOption> schemaToCliOptions(const CreateSchema &schema)
 }
 
 /**
- * After parsing, walk the schema and build a QVariantMap containing only
- * the options the user explicitly set (non-default values).  The daemon
+ * After parsing, look up each flag the user passed in the schema index
+ * and build a QVariantMap containing only those options.  The daemon
  * fills in defaults for anything omitted.
  */
 static QVariantMap cliToVariantMap(const QCommandLineParser &parser,
-                                   const CreateSchema &schema)
+                                   const CreateSchemaIndex &schema)
 {
     QVariantMap map;
-    for (const auto &opt : schema.allOptions()) {
-        const QString flag = opt.cliFlag();
+    QSet<QString> handled;
+    const QStringList names = parser.optionNames();
+    for (const QString &name : names) {
+        const CreateSchemaOption *opt = schema.findByFlag(name);
+        if (!opt && name.startsWith(QLatin1String("no-"))) {
+            opt = schema.findByFlag(name.mid(3));
+            if (opt && opt->type != QStringLiteral("boolean")) {
+                opt = nullptr;
+            }
+        }
+        // Not a schema flag (--image), or already seen
+        if (!opt || handled.contains(opt->key)) {
+            continue;
+        }
+        handled.insert(opt->key);
+        const QString flag = opt->cliFlag();
 
-        if (opt.type == QStringLiteral("boolean")) {
+        if (opt->type == QStringLiteral("boolean")) {
             const bool hasPositive = parser.isSet(flag);
             const bool hasNegative = parser.isSet(QStringLiteral("no-") + flag);
 
-            // Last-one-wins if the user passes both (unlikely but harmless).
-            // Only insert when explicitly set so the daemon uses its defaults
-            // for anything omitted.
+            // If the user passes both (unlikely but harmless), neither
+            // wins and the daemon uses its default.
             if (hasPositive && !hasNegative) {
-                map.insert(opt.key, true);
+                map.insert(opt->key, true);
             } else if (hasNegative && !hasPositive) {
-                map.insert(opt.key, false);
-            }
-        } else if (opt.type == QStringLiteral("string")) {
-            if (parser.isSet(flag)) {
-                map.insert(opt.key, parser.value(flag));
-            }
-        } else if (opt.type == QStringLiteral("array")) {
-            QStringList values = parser.values(flag);
-            if (!values.isEmpty()) {
-                map.insert(opt.key, values);
+                map.insert(opt->key, false);
             }
+        } else if (opt->type == QStringLiteral("string")) {
+            map.insert(opt->key, parser.value(flag));
+        } else if (opt->type == QStringLiteral("array")) {
+            map.insert(opt->key, parser.values(flag));
         }
     }
     return map;
@@ -364,15 +637,11 @@ QCoro::Task<int> cmdCreate(KapsuleClient &client, const QStringList &args)
 {
     auto &o = out();
 
-    // ---- Fetch the option schema from the daemon ----
-    QString schemaJson = co_await client.getCreateSchema();
-    if (schemaJson.isEmpty()) {
-        o.error("Failed to retrieve create-container schema from daemon");
-        co_return 1;
-    }
-    CreateSchema schema = parseCreateSchema(schemaJson);
+    // ---- Get the option schema (usually from the local cache) ----
+    const CreateSchemaIndex schemaIndex = co_await client.createSchemaIndex();
+    const CreateSchema &schema = schemaIndex.schema();
     if (schema.version == 0) {
-        o.error("Failed to parse create-container schema");
+        o.error("Failed to retrieve create-container schema from daemon");
         co_return 1;
     }
 
@@ -396,7 +665,7 @@ QCoro::Task<int> cmdCreate(KapsuleClient &client, const QStringList &args)
     // ---- Parse ----
     QStringList fullArgs = QStringList{programName + QStringLiteral(" create")} + args;
     if (!parser.parse(fullArgs)) {
-        o.error(parser.errorText().toStdString());
+        reportError(o, parser.errorText().toStdString());
         co_return 1;
     }
 
@@ -407,7 +676,7 @@ QCoro::Task<int> cmdCreate(KapsuleClient &client, const QStringList &args)
 
     QStringList positional = parser.positionalArguments();
     if (positional.isEmpty()) {
-        o.error("Container name required");
+        reportError(o, "Container name required");
         o.hint(QStringLiteral("Usage: %1 create <name> [--image <image>]").arg(programName).toStdString());
         co_return 1;
     }
@@ -416,19 +685,13 @@ QCoro::Task<int> cmdCreate(KapsuleClient &client, const QStringList &args)
     QString image = parser.value(QStringLiteral("image"));
 
     // Build variant map from user-specified flags only
-    QVariantMap optionsMap = cliToVariantMap(parser, schema);
+    QVariantMap optionsMap = cliToVariantMap(parser, schemaIndex);
 
     o.section(QStringLiteral("Creating container: %1").arg(name).toStdString());
 
     auto result = co_await client.createContainer(name, image, optionsMap, makeOutputCallbacks(o));
 
-    if (!result.success) {
-        o.failure(result.error.toStdString());
-        co_return 1;
-    }
-
-    o.success("Container created");
-    co_return 0;
+    co_return reportOperation(o, result, "Container created");
 }
 
 // =============================================================================
@@ -451,7 +714,7 @@ QCoro::Task<int> cmdEnter(KapsuleClient &client, const QStringList &args)
 
     QStringList fullArgs = QStringList{programName + QStringLiteral(" enter")} + args;
     if (!parser.parse(fullArgs)) {
-        o.error(parser.errorText().toStdString());
+        reportError(o, parser.errorText().toStdString());
         co_return 1;
     }
 
@@ -479,7 +742,29 @@ QCoro::Task<int> cmdEnter(KapsuleClient &client, const QStringList &args)
         command = positional.mid(1);
     }
 
-    auto config = co_await client.config();
+    // Container names cannot contain glob characters, so a names-only
+    // filter on the name matches exactly one container without loading any.
+    const auto exactName = [](const QString &name) {
+        ContainerFilter filter;
+        filter.name = name;
+        filter.fields = {QStringLiteral("name")};
+        return filter;
+    };
+
+    // An explicit name only needs checking if it turns out to be the
+    // default container, but the lookup is cheap enough to send along
+    // with the config request rather than after it.
+    QVariantMap config;
+    std::optional<bool> containerExists;
+    if (containerName.isEmpty()) {
+        config = co_await client.config();
+    } else {
+        auto [fetchedConfig, matches] = co_await whenAll(
+            client.config(), client.listContainers(exactName(containerName)));
+        config = std::move(fetchedConfig);
+        containerExists = !matches.isEmpty();
+    }
+
     if (config.contains(QStringLiteral("error"))) {
         o.error(config.value(QStringLiteral("error")).toString().toStdString());
         co_return 1;
@@ -490,24 +775,22 @@ QCoro::Task<int> cmdEnter(KapsuleClient &client, const QStringList &args)
     const QString targetContainer = containerName.isEmpty() ? defaultContainer : containerName;
 
     if (!targetContainer.isEmpty() && targetContainer == defaultContainer) {
-        bool containerExists = false;
-        const auto containers = co_await client.listContainers();
-        for (const auto &container : containers) {
-            if (container.name() == targetContainer) {
-                containerExists = true;
-                break;
-            }
+        if (!containerExists) {
+            containerExists = !(co_await client.listContainers(exactName(targetContainer))).isEmpty();
         }
 
-        if (!containerExists) {
+        if (!*containerExists) {
             o.section(QStringLiteral("Creating container: %1").arg(targetContainer).toStdString());
             auto createResult = co_await client.createContainer(targetContainer, defaultImage, {},
                 makeOutputCallbacks(o));
 
+            // Losing a race with another enter is fine; anything else is
+            // reported like a plain create, with its events in json mode.
             if (!createResult.success
-                && !createResult.error.contains(QStringLiteral("already exists"), Qt::CaseInsensitive)) {
-                o.failure(createResult.error.toStdString());
-                co_return 1;
+                && createResult.error.contains(QStringLiteral("already exists"), Qt::CaseInsensitive)) {
+                currentOperation.clear();
+            } else if (const int status = reportOperation(o, createResult, {}); status != 0) {
+                co_return status;
             }
         }
     }
@@ -544,6 +827,12 @@ QCoro::Task<int> cmdEnter(KapsuleClient &client, const QStringList &args)
     }
     execArgv.push_back(nullptr);
 
+    // Nothing left to cancel: give Ctrl-C its default behaviour back
+    std::signal(SIGINT, SIG_DFL);
+
+    // The command replaces this process, so this is the CLI's exit
+    printStatistics(client);
+
     if (!shouldEmitOsc777()) {
         execvp(execArgv[0], execArgv.data());
 
@@ -596,6 +885,152 @@ QCoro::Task<int> cmdEnter(KapsuleClient &client, const QStringList &args)
 // Command: list
 // =============================================================================
 
+// Render the container table.  Escape sequences are only used with
+// colors; rows named in highlighted get their status in reverse video.
+static std::string containerTable(const QList<Container> &containers, bool colors,
+                                  const QSet<QString> &highlighted = {})
+{
+    const auto sgr = [colors](const char *code) {
+        return colors ? std::string("\033[") + code + "m" : std::string();
+    };
+
+    std::ostringstream table;
+    table << sgr("1")
+          << std::left << std::setw(20) << "NAME"
+          << std::setw(12) << "STATUS"
+          << std::setw(25) << "IMAGE"
+          << std::setw(12) << "MODE"
+          << "CREATED"
+          << sgr("0") << '\n';
+
+    for (const Container &c : containers) {
+        std::string status;
+        std::string color;
+        switch (c.state()) {
+        case Container::State::Running:
+            color = sgr("32");
+            status = "Running";
+            break;
+        case Container::State::Stopped:
+            color = sgr("31");
+            status = "Stopped";
+            break;
+        case Container::State::Starting:
+            color = sgr("33");
+            status = "Starting";
+            break;
+        case Container::State::Stopping:
+            color = sgr("33");
+            status = "Stopping";
+            break;
+        default:
+            color = sgr("90");
+            status = "Unknown";
+        }
+        const std::string highlight = highlighted.contains(c.name()) ? sgr("7") : std::string();
+
+        // Pad outside the escape sequences so the columns stay aligned
+        table << color << std::left << std::setw(20) << c.name().toStdString()
+              << highlight << status << sgr("0")
+              << std::string(12 - status.size(), ' ')
+              << std::setw(25) << c.image().toStdString()
+              << std::setw(12) << containerModeToString(c.mode()).toStdString()
+              << c.created().toString(Qt::ISODate).left(10).toStdString()
+              << '\n';
+    }
+    return table.str();
+}
+
+// kapsule list --watch: redraw the list whenever the daemon reports a
+// change.  The container list is fetched once, into the client's cache;
+// after that the cache, kept current by the daemon's signals, is all
+// that is read, so an idle watch makes no D-Bus calls at all.
+static QCoro::Task<int> watchContainers(KapsuleClient &client, const ContainerFilter &filter)
+{
+    auto &o = out();
+    const bool tty = isatty(STDOUT_FILENO) == 1 && !jsonOutput();
+    const QRegularExpression namePattern = filter.name.isEmpty()
+        ? QRegularExpression()
+        : QRegularExpression::fromWildcard(filter.name, Qt::CaseSensitive,
+                                           QRegularExpression::NonPathWildcardConversion);
+    const auto matches = [&](const Container &c) {
+        return (filter.states.isEmpty() || filter.states.contains(c.state()))
+            && (filter.name.isEmpty() || namePattern.match(c.name()).hasMatch());
+    };
+
+    const auto visibleContainers = [&] {
+        QList<Container> visible;
+        const QList<Container> cached = client.cachedContainers();
+        for (const Container &c : cached) {
+            if (matches(c)) {
+                visible.append(c);
+            }
+        }
+        return visible;
+    };
+
+    if (!co_await client.loadContainerCache()) {
+        o.error("Failed to list containers");
+        co_return 1;
+    }
+    QList<Container> containers = visibleContainers();
+
+    QHash<QString, Container::State> previousStates;
+    QStringList previousRows;
+    bool firstFrame = true;
+    while (true) {
+        QStringList rows;
+        QSet<QString> changed;
+        QHash<QString, Container::State> states;
+        for (const Container &c : containers) {
+            rows.append(QStringList{c.name(), QString::number(static_cast<int>(c.state())), c.image(),
+                                    containerModeToString(c.mode()), c.created().toString(Qt::ISODate)}
+                            .join(QLatin1Char('\n')));
+            states.insert(c.name(), c.state());
+            const auto previous = previousStates.constFind(c.name());
+            if (!firstFrame && (previous == previousStates.cend() || *previous != c.state())) {
+                changed.insert(c.name());
+            }
+        }
+
+        // Signals also fire for containers the filter hides
+        if (firstFrame || rows != previousRows) {
+            if (jsonOutput()) {
+                QJsonArray items;
+                for (const Container &c : containers) {
+                    items.append(containerToJson(c));
+                }
+                printJsonList(items);
+            } else {
+                std::ostringstream frame;
+                if (tty) {
+                    frame << "\033[H\033[2J";
+                } else if (!firstFrame) {
+                    frame << '\n';
+                }
+                frame << containerTable(containers, tty, changed);
+                if (containers.isEmpty()) {
+                    frame << (tty ? "\033[90m" : "")
+                          << (filter.states.isEmpty() ? "No containers found." : "No running containers.")
+                          << (tty ? "\033[0m" : "") << '\n';
+                }
+                if (tty) {
+                    frame << "\033[90mUpdated "
+                          << QTime::currentTime().toString(QStringLiteral("HH:mm:ss")).toStdString()
+                          << " - press Ctrl-C to quit\033[0m\n";
+                }
+                std::cout << frame.str() << std::flush;
+            }
+            previousRows = rows;
+            previousStates = states;
+            firstFrame = false;
+        }
+
+        co_await qCoro(&client, &KapsuleClient::containersChanged);
+        containers = visibleContainers();
+    }
+}
+
 QCoro::Task<int> cmdList(KapsuleClient &client, const QStringList &args)
 {
     auto &o = out();
@@ -608,11 +1043,16 @@ QCoro::Task<int> cmdList(KapsuleClient &client, const QStringList &args)
          QStringLiteral("Show only running containers")},
         {{QStringLiteral("a"), QStringLiteral("all")},
          QStringLiteral("Show all containers including stopped (default)")},
+        {QStringLiteral("name"),
+         QStringLiteral("Show only containers whose name matches a shell-style pattern"),
+         QStringLiteral("pattern")},
+        {{QStringLiteral("w"), QStringLiteral("watch")},
+         QStringLiteral("Keep the list on screen and update it whenever a container changes")},
     });
 
     QStringList fullArgs = QStringList{programName + QStringLiteral(" list")} + args;
     if (!parser.parse(fullArgs)) {
-        o.error(parser.errorText().toStdString());
+        reportError(o, parser.errorText().toStdString());
         co_return 1;
     }
 
@@ -623,70 +1063,76 @@ QCoro::Task<int> cmdList(KapsuleClient &client, const QStringList &args)
 
     const bool showRunningOnly = parser.isSet(QStringLiteral("running"));
 
-    auto containers = co_await client.listContainers();
+    // Let the daemon do the filtering, so that stopped containers are
+    // not even looked at for --running.
+    ContainerFilter filter;
+    if (showRunningOnly) {
+        filter.states = {Container::State::Running};
+    }
+    filter.name = parser.value(QStringLiteral("name"));
 
-    if (containers.isEmpty()) {
-        o.dim("No containers found.");
-        co_return 0;
+    if (parser.isSet(QStringLiteral("watch"))) {
+        co_return co_await watchContainers(client, filter);
     }
 
-    // Filter if --running
-    if (showRunningOnly) {
-        containers.erase(
-            std::remove_if(containers.begin(), containers.end(),
-                [](const Container &c) { return c.state() != Container::State::Running; }),
-            containers.end());
-
-        if (containers.isEmpty()) {
-            o.dim("No running containers.");
-            co_return 0;
+    auto containers = co_await client.listContainers(filter);
+
+    if (jsonOutput()) {
+        QJsonArray items;
+        for (const Container &c : containers) {
+            items.append(containerToJson(c));
         }
+        printJsonList(items);
+        co_return 0;
     }
 
-    // Print table header
-    std::cout << rang::style::bold
-              << std::left << std::setw(20) << "NAME"
-              << std::setw(12) << "STATUS"
-              << std::setw(25) << "IMAGE"
-              << std::setw(12) << "MODE"
-              << "CREATED"
-              << rang::style::reset << '\n';
+    if (containers.isEmpty()) {
+        o.dim(showRunningOnly ? "No running containers." : "No containers found.");
+        co_return 0;
+    }
 
-    // Print rows
-    for (const Container &c : containers) {
-        std::string status;
-        switch (c.state()) {
-        case Container::State::Running:
-            std::cout << rang::fg::green;
-            status = "Running";
-            break;
-        case Container::State::Stopped:
-            std::cout << rang::fg::red;
-            status = "Stopped";
-            break;
-        case Container::State::Starting:
-            std::cout << rang::fg::yellow;
-            status = "Starting";
-            break;
-        case Container::State::Stopping:
-            std::cout << rang::fg::yellow;
-            status = "Stopping";
-            break;
-        default:
-            std::cout << rang::fg::gray;
-            status = "Unknown";
+    std::cout << containerTable(containers, isatty(STDOUT_FILENO) == 1);
+    co_return 0;
+}
+
+// =============================================================================
+// Container selection for start/stop/rm
+// =============================================================================
+
+// Resolve the containers a lifecycle command acts on: the names given on
+// the command line, or every container (only running ones with
+// runningOnly) when a selector is used.  Returns nullopt after printing
+// an error if the arguments don't make sense.
+static QCoro::Task<std::optional<QStringList>> selectContainers(
+    KapsuleClient &client, QStringList names, bool all, bool runningOnly)
+{
+    auto &o = out();
+
+    if (!all && !runningOnly) {
+        if (names.isEmpty()) {
+            reportError(o, "Container name required");
+            co_return std::nullopt;
         }
+        names.removeDuplicates();
+        co_return names;
+    }
 
-        std::cout << std::left << std::setw(20) << c.name().toStdString()
-                  << std::setw(12) << status
-                  << rang::fg::reset
-                  << std::setw(25) << c.image().toStdString()
-                  << std::setw(12) << containerModeToString(c.mode()).toStdString()
-                  << c.created().toString(Qt::ISODate).left(10).toStdString()
-                  << '\n';
+    if (!names.isEmpty()) {
+        reportError(o, "Container names cannot be combined with --all or --running");
+        co_return std::nullopt;
     }
 
-    co_return 0;
+    ContainerFilter filter;
+    if (runningOnly) {
+        filter.states = {Container::State::Running};
+    }
+    filter.fields = {QStringLiteral("name")};
+
+    const auto containers = co_await client.listContainers(filter);
+    for (const auto &c : containers) {
+        names.append(c.name());
+    }
+    co_return names;
 }
 
 // =============================================================================
@@ -698,13 +1144,18 @@ QCoro::Task<int> cmdStart(KapsuleClient &client, const QStringList &args)
     auto &o = out();
 
     QCommandLineParser parser;
-    parser.setApplicationDescription(QStringLiteral("Start a stopped container"));
+    parser.setApplicationDescription(QStringLiteral("Start stopped containers"));
     parser.addHelpOption();
-    parser.addPositionalArgument(QStringLiteral("name"), QStringLiteral("Container name"));
+    parser.addPositionalArgument(QStringLiteral("names"), QStringLiteral("Container names"),
+                                 QStringLiteral("<name>..."));
+    parser.addOptions({
+        {{QStringLiteral("a"), QStringLiteral("all")},
+         QStringLiteral("Start all containers")},
+    });
 
     QStringList fullArgs = QStringList{programName + QStringLiteral(" start")} + args;
     if (!parser.parse(fullArgs)) {
-        o.error(parser.errorText().toStdString());
+        reportError(o, parser.errorText().toStdString());
         co_return 1;
     }
 
@@ -713,25 +1164,26 @@ QCoro::Task<int> cmdStart(KapsuleClient &client, const QStringList &args)
         co_return 0;
     }
 
-    QStringList positional = parser.positionalArguments();
-    if (positional.isEmpty()) {
-        o.error("Container name required");
+    const auto names = co_await selectContainers(client, parser.positionalArguments(),
+                                                 parser.isSet(QStringLiteral("all")), false);
+    if (!names) {
         co_return 1;
     }
+    if (names->isEmpty()) {
+        o.info("No containers to start");
+        co_return 0;
+    }
 
-    QString name = positional.at(0);
-
-    o.section(QStringLiteral("Starting container: %1").arg(name).toStdString());
-
-    auto result = co_await client.startContainer(name, makeOutputCallbacks(o));
-
-    if (!result.success) {
-        o.failure(result.error.toStdString());
-        co_return 1;
+    OperationResult result;
+    if (names->size() == 1) {
+        o.section(QStringLiteral("Starting container: %1").arg(names->first()).toStdString());
+        result = co_await client.startContainer(names->first(), makeOutputCallbacks(o));
+    } else {
+        o.section(QStringLiteral("Starting %1 containers").arg(names->size()).toStdString());
+        result = co_await client.startContainers(*names, makeOutputCallbacks(o));
     }
 
-    o.success("Container started");
-    co_return 0;
+    co_return reportOperation(o, result, names->size() == 1 ? "Container started" : "Containers started");
 }
 
 // =============================================================================
@@ -743,17 +1195,22 @@ QCoro::Task<int> cmdStop(KapsuleClient &client, const QStringList &args)
     auto &o = out();
 
     QCommandLineParser parser;
-    parser.setApplicationDescription(QStringLiteral("Stop a running container"));
+    parser.setApplicationDescription(QStringLiteral("Stop running containers"));
     parser.addHelpOption();
-    parser.addPositionalArgument(QStringLiteral("name"), QStringLiteral("Container name"));
+    parser.addPositionalArgument(QStringLiteral("names"), QStringLiteral("Container names"),
+                                 QStringLiteral("<name>..."));
     parser.addOptions({
         {{QStringLiteral("f"), QStringLiteral("force")},
          QStringLiteral("Force stop the container")},
+        {{QStringLiteral("a"), QStringLiteral("all")},
+         QStringLiteral("Stop all containers")},
+        {QStringLiteral("running"),
+         QStringLiteral("Stop all running containers")},
     });
 
     QStringList fullArgs = QStringList{programName + QStringLiteral(" stop")} + args;
     if (!parser.parse(fullArgs)) {
-        o.error(parser.errorText().toStdString());
+        reportError(o, parser.errorText().toStdString());
         co_return 1;
     }
 
@@ -762,26 +1219,29 @@ QCoro::Task<int> cmdStop(KapsuleClient &client, const QStringList &args)
         co_return 0;
     }
 
-    QStringList positional = parser.positionalArguments();
-    if (positional.isEmpty()) {
-        o.error("Container name required");
+    const auto names = co_await selectContainers(client, parser.positionalArguments(),
+                                                 parser.isSet(QStringLiteral("all")),
+                                                 parser.isSet(QStringLiteral("running")));
+    if (!names) {
         co_return 1;
     }
+    if (names->isEmpty()) {
+        o.info("No containers to stop");
+        co_return 0;
+    }
 
-    QString name = positional.at(0);
     bool force = parser.isSet(QStringLiteral("force"));
 
-    o.section(QStringLiteral("Stopping container: %1").arg(name).toStdString());
-
-    auto result = co_await client.stopContainer(name, force, makeOutputCallbacks(o));
-
-    if (!result.success) {
-        o.failure(result.error.toStdString());
-        co_return 1;
+    OperationResult result;
+    if (names->size() == 1) {
+        o.section(QStringLiteral("Stopping container: %1").arg(names->first()).toStdString());
+        result = co_await client.stopContainer(names->first(), force, makeOutputCallbacks(o));
+    } else {
+        o.section(QStringLiteral("Stopping %1 containers").arg(names->size()).toStdString());
+        result = co_await client.stopContainers(*names, force, makeOutputCallbacks(o));
     }
 
-    o.success("Container stopped");
-    co_return 0;
+    co_return reportOperation(o, result, names->size() == 1 ? "Container stopped" : "Containers stopped");
 }
 
 // =============================================================================
@@ -793,17 +1253,22 @@ QCoro::Task<int> cmdRm(KapsuleClient &client, const QStringList &args)
     auto &o = out();
 
     QCommandLineParser parser;
-    parser.setApplicationDescription(QStringLiteral("Remove a container"));
+    parser.setApplicationDescription(QStringLiteral("Remove containers"));
     parser.addHelpOption();
-    parser.addPositionalArgument(QStringLiteral("name"), QStringLiteral("Container name"));
+    parser.addPositionalArgument(QStringLiteral("names"), QStringLiteral("Container names"),
+                                 QStringLiteral("<name>..."));
     parser.addOptions({
         {{QStringLiteral("f"), QStringLiteral("force")},
          QStringLiteral("Force removal even if running")},
+        {{QStringLiteral("a"), QStringLiteral("all")},
+         QStringLiteral("Remove all containers")},
+        {QStringLiteral("running"),
+         QStringLiteral("Remove all running containers (requires --force)")},
     });
 
     QStringList fullArgs = QStringList{programName + QStringLiteral(" rm")} + args;
     if (!parser.parse(fullArgs)) {
-        o.error(parser.errorText().toStdString());
+        reportError(o, parser.errorText().toStdString());
         co_return 1;
     }
 
@@ -812,26 +1277,29 @@ QCoro::Task<int> cmdRm(KapsuleClient &client, const QStringList &args)
         co_return 0;
     }
 
-    QStringList positional = parser.positionalArguments();
-    if (positional.isEmpty()) {
-        o.error("Container name required");
+    const auto names = co_await selectContainers(client, parser.positionalArguments(),
+                                                 parser.isSet(QStringLiteral("all")),
+                                                 parser.isSet(QStringLiteral("running")));
+    if (!names) {
         co_return 1;
     }
+    if (names->isEmpty()) {
+        o.info("No containers to remove");
+        co_return 0;
+    }
 
-    QString name = positional.at(0);
     bool force = parser.isSet(QStringLiteral("force"));
 
-    o.section(QStringLiteral("Removing container: %1").arg(name).toStdString());
-
-    auto result = co_await client.deleteContainer(name, force, makeOutputCallbacks(o));
-
-    if (!result.success) {
-        o.failure(result.error.toStdString());
-        co_return 1;
+    OperationResult result;
+    if (names->size() == 1) {
+        o.section(QStringLiteral("Removing container: %1").arg(names->first()).toStdString());
+        result = co_await client.deleteContainer(names->first(), force, makeOutputCallbacks(o));
+    } else {
+        o.section(QStringLiteral("Removing %1 containers").arg(names->size()).toStdString());
+        result = co_await client.deleteContainers(*names, force, makeOutputCallbacks(o));
     }
 
-    o.success("Container removed");
-    co_return 0;
+    co_return reportOperation(o, result, names->size() == 1 ? "Container removed" : "Containers removed");
 }
 
 // =============================================================================
@@ -849,7 +1317,7 @@ QCoro::Task<int> cmdConfig(KapsuleClient &client, const QStringList &args)
 
     QStringList fullArgs = QStringList{programName + QStringLiteral(" config")} + args;
     if (!parser.parse(fullArgs)) {
-        o.error(parser.errorText().toStdString());
+        reportError(o, parser.errorText().toStdString());
         co_return 1;
     }
 
@@ -868,6 +1336,24 @@ QCoro::Task<int> cmdConfig(KapsuleClient &client, const QStringList &args)
         co_return 1;
     }
 
+    QStringList validKeys = {QStringLiteral("default_container"), QStringLiteral("default_image")};
+    if (!key.isEmpty() && !validKeys.contains(key)) {
+        reportError(o, QStringLiteral("Unknown config key: %1").arg(key).toStdString());
+        o.hint(QStringLiteral("Valid keys: %1").arg(validKeys.join(QStringLiteral(", "))).toStdString());
+        co_return 1;
+    }
+
+    if (jsonOutput()) {
+        QJsonObject json;
+        for (const QString &k : validKeys) {
+            if (key.isEmpty() || k == key) {
+                json.insert(k, QJsonValue::fromVariant(config.value(k)));
+            }
+        }
+        printJson(json);
+        co_return 0;
+    }
+
     if (key.isEmpty()) {
         // Show all config
         o.section("Configuration");
@@ -882,12 +1368,6 @@ QCoro::Task<int> cmdConfig(KapsuleClient &client, const QStringList &args)
         }
     } else {
         // Show single key
-        QStringList validKeys = {QStringLiteral("default_container"), QStringLiteral("default_image")};
-        if (!validKeys.contains(key)) {
-            o.error(QStringLiteral("Unknown config key: %1").arg(key).toStdString());
-            o.hint(QStringLiteral("Valid keys: %1").arg(validKeys.join(QStringLiteral(", "))).toStdString());
-            co_return 1;
-        }
         o.info(QStringLiteral("%1 = %2").arg(key, config.value(key).toString()).toStdString());
     }
 
@@ -930,7 +1410,7 @@ QCoro::Task<int> cmdImage(KapsuleClient &client, const QStringList &args)
     } else if (subcommand == QStringLiteral("refresh")) {
         co_return co_await cmdImageRefresh(client, subArgs);
     } else {
-        o.error(QStringLiteral("Unknown image subcommand: %1").arg(subcommand).toStdString());
+        reportError(o, QStringLiteral("Unknown image subcommand: %1").arg(subcommand).toStdString());
         co_return 1;
     }
 }
@@ -949,7 +1429,7 @@ QCoro::Task<int> cmdImageRefresh(KapsuleClient &client, const QStringList &args)
 
     QStringList fullArgs = QStringList{programName + QStringLiteral(" image refresh")} + args;
     if (!parser.parse(fullArgs)) {
-        o.error(parser.errorText().toStdString());
+        reportError(o, parser.errorText().toStdString());
         co_return 1;
     }
 
@@ -969,12 +1449,7 @@ QCoro::Task<int> cmdImageRefresh(KapsuleClient &client, const QStringList &args)
 
     auto result = co_await client.refreshImages(imageSpec, makeOutputCallbacks(o));
 
-    if (!result.success) {
-        o.failure(result.error.toStdString());
-        co_return 1;
-    }
-
-    co_return 0;
+    co_return reportOperation(o, result, {});
 }
 
 // =============================================================================
@@ -996,7 +1471,7 @@ QCoro::Task<int> cmdImageImport(KapsuleClient &client, const QStringList &args)
 
     QStringList fullArgs = QStringList{programName + QStringLiteral(" image import")} + args;
     if (!parser.parse(fullArgs)) {
-        o.error(parser.errorText().toStdString());
+        reportError(o, parser.errorText().toStdString());
         co_return 1;
     }
 
@@ -1007,7 +1482,7 @@ QCoro::Task<int> cmdImageImport(KapsuleClient &client, const QStringList &args)
 
     QStringList positional = parser.positionalArguments();
     if (positional.isEmpty()) {
-        o.error("Image path required");
+        reportError(o, "Image path required");
         o.hint(QStringLiteral("Usage: %1 image import <path> [--alias <name>]").arg(programName).toStdString());
         co_return 1;
     }
@@ -1024,20 +1499,14 @@ QCoro::Task<int> cmdImageImport(KapsuleClient &client, const QStringList &args)
 
     auto result = co_await client.importImage(path, alias, makeOutputCallbacks(o));
 
-    if (!result.success) {
-        o.failure(result.error.toStdString());
-        co_return 1;
-    }
-
-    o.success(QStringLiteral("Image imported successfully as \"%1\"").arg(alias).toStdString());
-    co_return 0;
+    co_return reportOperation(o, result, QStringLiteral("Image imported successfully as \"%1\"").arg(alias).toStdString());
 }
 
 // =============================================================================
 // Command: image list
 // =============================================================================
 
-static QString formatImageSize(qint64 bytes)
+static QString formatSize(qint64 bytes)
 {
     if (bytes < 0) {
         return QStringLiteral("-");
@@ -1060,7 +1529,7 @@ QCoro::Task<int> cmdImageList(KapsuleClient &client, const QStringList &args)
 
     QStringList fullArgs = QStringList{programName + QStringLiteral(" image list")} + args;
     if (!parser.parse(fullArgs)) {
-        o.error(parser.errorText().toStdString());
+        reportError(o, parser.errorText().toStdString());
         co_return 1;
     }
 
@@ -1069,20 +1538,17 @@ QCoro::Task<int> cmdImageList(KapsuleClient &client, const QStringList &args)
         co_return 0;
     }
 
-    QString json = co_await client.listImages();
-    if (json.isEmpty()) {
-        o.error("Failed to retrieve image list from daemon");
-        co_return 1;
-    }
+    const auto images = co_await client.listImages();
 
-    QJsonParseError parseError;
-    QJsonDocument doc = QJsonDocument::fromJson(json.toUtf8(), &parseError);
-    if (parseError.error != QJsonParseError::NoError) {
-        o.error(QStringLiteral("Failed to parse image list: %1").arg(parseError.errorString()).toStdString());
-        co_return 1;
+    if (jsonOutput()) {
+        QJsonArray items;
+        for (const Image &img : images) {
+            items.append(imageToJson(img));
+        }
+        printJsonList(items);
+        co_return 0;
     }
 
-    QJsonArray images = doc.array();
     if (images.isEmpty()) {
         o.dim("No images found.");
         co_return 0;
@@ -1098,25 +1564,16 @@ QCoro::Task<int> cmdImageList(KapsuleClient &client, const QStringList &args)
               << rang::style::reset << '\n';
 
     // Print rows
-    for (const QJsonValue &val : images) {
-        QJsonObject img = val.toObject();
-
-        QString fingerprint = img.value(QStringLiteral("fingerprint")).toString().left(12);
-        QString description = img.value(QStringLiteral("description")).toString();
-        qint64 size = img.value(QStringLiteral("size")).toInteger(-1);
-        QString uploaded = img.value(QStringLiteral("uploaded_at")).toString().left(10);
-
-        // Extract first alias
-        QString alias;
-        QJsonArray aliases = img.value(QStringLiteral("aliases")).toArray();
-        if (!aliases.isEmpty()) {
-            alias = aliases.first().toObject().value(QStringLiteral("name")).toString();
-        }
+    for (const Image &img : images) {
+        const QString fingerprint = img.fingerprint().left(12);
+        const QString alias = img.aliases().value(0);
+        const QString description = img.description();
+        const QString uploaded = img.uploaded().toString(Qt::ISODate).left(10);
 
         std::cout << std::left << std::setw(14) << fingerprint.toStdString()
                   << std::setw(20) << alias.toStdString()
                   << std::setw(30) << description.left(28).toStdString()
-                  << std::setw(10) << formatImageSize(size).toStdString()
+                  << std::setw(10) << formatSize(img.size()).toStdString()
                   << uploaded.toStdString()
                   << '\n';
     }
@@ -1140,7 +1597,7 @@ QCoro::Task<int> cmdImageDelete(KapsuleClient &client, const QStringList &args)
 
     QStringList fullArgs = QStringList{programName + QStringLiteral(" image delete")} + args;
     if (!parser.parse(fullArgs)) {
-        o.error(parser.errorText().toStdString());
+        reportError(o, parser.errorText().toStdString());
         co_return 1;
     }
 
@@ -1151,7 +1608,7 @@ QCoro::Task<int> cmdImageDelete(KapsuleClient &client, const QStringList &args)
 
     QStringList positional = parser.positionalArguments();
     if (positional.isEmpty()) {
-        o.error("Image identifier required");
+        reportError(o, "Image identifier required");
         o.hint(QStringLiteral("Usage: %1 image delete <fingerprint-or-alias>").arg(programName).toStdString());
         co_return 1;
     }
@@ -1162,12 +1619,187 @@ QCoro::Task<int> cmdImageDelete(KapsuleClient &client, const QStringList &args)
 
     auto result = co_await client.deleteImage(identifier, makeOutputCallbacks(o));
 
-    if (!result.success) {
-        o.failure(result.error.toStdString());
+    co_return reportOperation(o, result, "Image deleted");
+}
+
+// =============================================================================
+// Command: top
+// =============================================================================
+
+QCoro::Task<int> cmdTop(KapsuleClient &client, const QStringList &args)
+{
+    auto &o = out();
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("Show live resource usage of running containers"));
+    parser.addHelpOption();
+    parser.addOptions({
+        {{QStringLiteral("n"), QStringLiteral("interval")},
+         QStringLiteral("Seconds between refreshes (default: 2)"),
+         QStringLiteral("seconds"), QStringLiteral("2")},
+        {{QStringLiteral("s"), QStringLiteral("sort")},
+         QStringLiteral("Sort by mem, cpu or name (default: mem)"),
+         QStringLiteral("column"), QStringLiteral("mem")},
+        {QStringLiteral("once"),
+         QStringLiteral("Print a single sample and exit (takes one interval to measure CPU)")},
+    });
+
+    QStringList fullArgs = QStringList{programName + QStringLiteral(" top")} + args;
+    if (!parser.parse(fullArgs)) {
+        reportError(o, parser.errorText().toStdString());
         co_return 1;
     }
 
-    o.success("Image deleted");
+    if (parser.isSet(QStringLiteral("help"))) {
+        std::cout << parser.helpText().toStdString();
+        co_return 0;
+    }
+
+    bool ok = false;
+    const double seconds = parser.value(QStringLiteral("interval")).toDouble(&ok);
+    if (!ok || seconds < 0.1) {
+        reportError(o, "--interval must be a number of seconds (at least 0.1)");
+        co_return 1;
+    }
+    const auto interval = std::chrono::milliseconds(static_cast<qint64>(seconds * 1000));
+
+    const QString sortBy = parser.value(QStringLiteral("sort"));
+    if (sortBy != QLatin1String("mem") && sortBy != QLatin1String("cpu") && sortBy != QLatin1String("name")) {
+        reportError(o, QStringLiteral("Unknown sort column: %1").arg(sortBy).toStdString());
+        co_return 1;
+    }
+
+    const bool once = parser.isSet(QStringLiteral("once"));
+    const bool tty = isatty(STDOUT_FILENO) == 1 && !jsonOutput();
+    const bool redraw = !once && tty;
+    // rang only styles std::cout itself, not the string the frame is built in
+    const std::string bold = tty ? "\033[1m" : "";
+    const std::string dim = tty ? "\033[90m" : "";
+    const std::string reset = tty ? "\033[0m" : "";
+
+    // CPU time is cumulative, so usage is the delta between two samples
+    QHash<QString, qint64> previousCpu;
+    auto previousTime = std::chrono::steady_clock::now();
+    bool firstSample = true;
+
+    auto stream = client.watchContainerStats(interval);
+    QCORO_FOREACH(const QList<ContainerStats> &sample, stream) {
+        const auto now = std::chrono::steady_clock::now();
+        const double elapsedNs = static_cast<double>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(now - previousTime).count());
+
+        struct Row {
+            ContainerStats stats;
+            double cpuPercent = -1;
+        };
+        QList<Row> rows;
+        QHash<QString, qint64> currentCpu;
+        for (const ContainerStats &stats : sample) {
+            Row row{stats};
+            const auto previous = previousCpu.constFind(stats.name());
+            if (previous != previousCpu.cend() && elapsedNs > 0) {
+                row.cpuPercent = 100.0 * static_cast<double>(stats.cpuTime() - *previous) / elapsedNs;
+            }
+            currentCpu.insert(stats.name(), stats.cpuTime());
+            rows.append(row);
+        }
+        previousCpu = std::move(currentCpu);
+        previousTime = now;
+
+        if (once && firstSample) {
+            firstSample = false;
+            continue;
+        }
+        firstSample = false;
+
+        std::sort(rows.begin(), rows.end(), [&sortBy](const Row &a, const Row &b) {
+            if (sortBy == QLatin1String("cpu")) {
+                return a.cpuPercent > b.cpuPercent;
+            }
+            if (sortBy == QLatin1String("name")) {
+                return a.stats.name() < b.stats.name();
+            }
+            return a.stats.memoryUsage() > b.stats.memoryUsage();
+        });
+
+        if (jsonOutput()) {
+            // One array per sample (json), or one object per container and sample (ndjson)
+            const QJsonValue time = jsonTime(QDateTime::currentDateTimeUtc());
+            QJsonArray items;
+            for (const Row &row : rows) {
+                const ContainerStats &s = row.stats;
+                items.append(QJsonObject{
+                    {QStringLiteral("time"), time},
+                    {QStringLiteral("name"), s.name()},
+                    {QStringLiteral("cpuPercent"), row.cpuPercent < 0 ? QJsonValue() : QJsonValue(row.cpuPercent)},
+                    {QStringLiteral("memoryUsage"), s.memoryUsage()},
+                    {QStringLiteral("memoryLimit"), s.memoryLimit()},
+                    {QStringLiteral("swapUsage"), s.swapUsage()},
+                    {QStringLiteral("diskUsage"), s.diskUsage()},
+                    {QStringLiteral("bytesReceived"), s.bytesReceived()},
+                    {QStringLiteral("bytesSent"), s.bytesSent()},
+                    {QStringLiteral("processCount"), s.processCount()},
+                });
+            }
+            printJsonList(items);
+            if (once) {
+                break;
+            }
+            continue;
+        }
+
+        // Build the whole frame first so it replaces the old one in one write
+        std::ostringstream frame;
+        if (redraw) {
+            frame << "\033[H\033[2J";
+        }
+        frame << bold
+              << std::left << std::setw(20) << "NAME"
+              << std::right << std::setw(7) << "CPU%"
+              << std::setw(11) << "MEM"
+              << std::setw(7) << "MEM%"
+              << std::setw(11) << "SWAP"
+              << std::setw(11) << "DISK"
+              << std::setw(11) << "NET RX"
+              << std::setw(11) << "NET TX"
+              << std::setw(7) << "PROCS"
+              << reset << '\n';
+
+        for (const Row &row : rows) {
+            const ContainerStats &s = row.stats;
+            const QString cpu = row.cpuPercent < 0
+                ? QStringLiteral("-")
+                : QString::number(row.cpuPercent, 'f', 1);
+            const QString memPercent = s.memoryLimit() > 0
+                ? QString::number(100.0 * static_cast<double>(s.memoryUsage()) / static_cast<double>(s.memoryLimit()), 'f', 1)
+                : QStringLiteral("-");
+
+            frame << std::left << std::setw(20) << s.name().left(19).toStdString()
+                  << std::right << std::setw(7) << cpu.toStdString()
+                  << std::setw(11) << formatSize(s.memoryUsage()).toStdString()
+                  << std::setw(7) << memPercent.toStdString()
+                  << std::setw(11) << formatSize(s.swapUsage()).toStdString()
+                  << std::setw(11) << formatSize(s.diskUsage()).toStdString()
+                  << std::setw(11) << formatSize(s.bytesReceived()).toStdString()
+                  << std::setw(11) << formatSize(s.bytesSent()).toStdString()
+                  << std::setw(7) << s.processCount()
+                  << '\n';
+        }
+
+        if (rows.isEmpty()) {
+            frame << dim << "No running containers." << reset << '\n';
+        }
+
+        std::cout << frame.str() << std::flush;
+
+        if (once) {
+            break;
+        }
+        if (!redraw) {
+            std::cout << '\n';
+        }
+    }
+
     co_return 0;
 }
 
@@ -1188,7 +1820,7 @@ int main(int argc, char *argv[])
     }
     
     app.setApplicationName(programName);
-    app.setApplicationVersion(QStringLiteral("0.2.1"));  // TODO: Get from build
+    app.setApplicationVersion(QStringLiteral(KAPSULE_VERSION_STRING));
     app.setOrganizationDomain(QStringLiteral("kde.org"));
     app.setOrganizationName(QStringLiteral("KDE"));
 
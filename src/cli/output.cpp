@@ -6,11 +6,111 @@
 #include "output.h"
 #include "rang.hpp"
 
+#include <sys/ioctl.h>
+#include <unistd.h>
+
 #include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstdlib>
 #include <iomanip>
+#include <sstream>
 
 namespace Kapsule {
 
+namespace {
+
+// Set by SIGWINCH; the next frame re-reads the terminal size.
+volatile std::sig_atomic_t terminalResized = 1;
+
+void handleResize(int)
+{
+    terminalResized = 1;
+}
+
+constexpr std::string_view Cyan = "\x1b[36m";
+constexpr std::string_view Green = "\x1b[32m";
+constexpr std::string_view Dim = "\x1b[2m";
+constexpr std::string_view Reset = "\x1b[0m";
+constexpr std::string_view EraseLine = "\x1b[K";
+constexpr std::string_view EraseBelow = "\x1b[J";
+
+constexpr int MinBarWidth = 10;
+constexpr int MaxBarWidth = 40;
+
+bool isContinuationByte(char c)
+{
+    return (static_cast<unsigned char>(c) & 0xC0) == 0x80;
+}
+
+// Terminal columns taken by UTF-8 text, counting one per code point
+int displayWidth(std::string_view text)
+{
+    return static_cast<int>(std::count_if(text.begin(), text.end(), [](char c) {
+        return !isContinuationByte(c);
+    }));
+}
+
+// Shortens text to at most width columns, marking the cut with an ellipsis
+std::string fitToWidth(std::string_view text, int width)
+{
+    if (width <= 0) {
+        return {};
+    }
+    if (displayWidth(text) <= width) {
+        return std::string(text);
+    }
+    int kept = 0;
+    size_t end = 0;
+    while (end < text.size()) {
+        if (!isContinuationByte(text[end])) {
+            if (kept == width - 1) {
+                break;
+            }
+            ++kept;
+        }
+        ++end;
+    }
+    return std::string(text.substr(0, end)) + "…";
+}
+
+std::string formatRate(double bytesPerSecond)
+{
+    constexpr double KB = 1024;
+    constexpr double MB = KB * 1024;
+    constexpr double GB = MB * 1024;
+    std::ostringstream text;
+    text << std::fixed << std::setprecision(1);
+    if (bytesPerSecond >= GB) {
+        text << bytesPerSecond / GB << " GB/s";
+    } else if (bytesPerSecond >= MB) {
+        text << bytesPerSecond / MB << " MB/s";
+    } else if (bytesPerSecond >= KB) {
+        text << bytesPerSecond / KB << " KB/s";
+    } else {
+        text << std::setprecision(0) << bytesPerSecond << " B/s";
+    }
+    return text.str();
+}
+
+std::string formatEta(double seconds)
+{
+    const auto total = static_cast<long long>(seconds + 0.5);
+    const long long hours = total / 3600;
+    const long long minutes = (total / 60) % 60;
+    std::ostringstream text;
+    text << "ETA ";
+    if (hours > 0) {
+        text << hours << ':' << std::setw(2) << std::setfill('0') << minutes;
+    } else {
+        text << minutes;
+    }
+    text << ':' << std::setw(2) << std::setfill('0') << total % 60;
+    return text.str();
+}
+
+} // namespace
+
 Output &out()
 {
     static Output instance;
@@ -19,6 +119,8 @@ Output &out()
 
 void Output::printPrefix(int extraIndent)
 {
+    // Messages replace a visible bar; the next update draws it again below
+    clearProgress();
     int total = m_indentLevel + extraIndent;
     for (int i = 0; i < total; ++i) {
         m_stream << ' ';
@@ -104,45 +206,268 @@ void Output::print(MessageType type, std::string_view msg, int extraIndent)
     m_indentLevel = savedIndent;
 }
 
-void Output::progress(std::string_view description, int current, int total)
+Output::Terminal Output::terminal()
 {
-    printPrefix();
+    if (m_terminal) {
+        return *m_terminal;
+    }
+    if (isatty(STDERR_FILENO) != 1) {
+        m_terminal = Terminal::None;
+        return *m_terminal;
+    }
+    const char *term = std::getenv("TERM");
+    m_terminal = (term == nullptr || *term == '\0' || std::string_view(term) == "dumb")
+        ? Terminal::Dumb
+        : Terminal::Ansi;
+
+    struct sigaction previous {};
+    sigaction(SIGWINCH, nullptr, &previous);
+    if (previous.sa_handler == SIG_DFL) {
+        struct sigaction action {};
+        action.sa_handler = handleResize;
+        sigemptyset(&action.sa_mask);
+        action.sa_flags = SA_RESTART;
+        sigaction(SIGWINCH, &action, nullptr);
+    }
+    return *m_terminal;
+}
+
+void Output::readTerminalSize()
+{
+    if (!terminalResized) {
+        return;
+    }
+    terminalResized = 0;
+    struct winsize size {};
+    if (ioctl(STDERR_FILENO, TIOCGWINSZ, &size) == 0) {
+        if (size.ws_col > 0) {
+            m_columns = size.ws_col;
+        }
+        if (size.ws_row > 0) {
+            m_rows = size.ws_row;
+        }
+    }
+}
+
+void Output::writeFrame(std::string_view frame)
+{
+    m_stream.flush();
+    while (!frame.empty()) {
+        const ssize_t written = ::write(STDERR_FILENO, frame.data(), frame.size());
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            // Drop the rest of the frame; the next one redraws the bars
+            return;
+        }
+        frame.remove_prefix(static_cast<size_t>(written));
+    }
+}
 
-    if (total > 0) {
-        // Determinate progress
-        int percent = (current * 100) / total;
-        int barWidth = 30;
-        int filled = (current * barWidth) / total;
-
-        m_stream << rang::fg::cyan << description << rang::fg::reset << " [";
-        for (int i = 0; i < barWidth; ++i) {
-            if (i < filled) {
-                m_stream << rang::fg::green << "█" << rang::fg::reset;
-            } else {
-                m_stream << rang::style::dim << "░" << rang::style::reset;
+std::string Output::renderBar(const ProgressBar &bar, bool ansi, int &width) const
+{
+    std::string line;
+    width = 0;
+    const auto append = [&](std::string_view style, std::string_view text) {
+        if (text.empty()) {
+            return;
+        }
+        if (ansi && !style.empty()) {
+            line.append(style).append(text).append(Reset);
+        } else {
+            line.append(text);
+        }
+        width += displayWidth(text);
+    };
+
+    std::string stats;
+    if (bar.total > 0) {
+        stats = std::to_string((static_cast<long long>(bar.current) * 100) / bar.total) + "%";
+    }
+    if (bar.rate > 0) {
+        stats += (stats.empty() ? "" : "  ") + formatRate(bar.rate);
+        if (bar.total > 0 && bar.current < bar.total) {
+            stats += "  " + formatEta((bar.total - bar.current) / bar.rate);
+        }
+    }
+    const int statsWidth = displayWidth(stats);
+
+    append({}, std::string(bar.indent, ' '));
+    // Leave the last column free so the cursor never wraps to a new line
+    const int available = m_columns - 1 - width;
+
+    if (bar.total > 0) {
+        // Determinate progress: description [bar] stats
+        const int room = available - statsWidth - 4;
+        const int descriptionWidth = displayWidth(bar.description);
+        int barWidth = std::min(MaxBarWidth, room - descriptionWidth);
+        if (barWidth < MinBarWidth) {
+            barWidth = std::clamp(room, 0, MinBarWidth);
+        }
+        const int filled =
+            static_cast<int>((static_cast<long long>(std::min(bar.current, bar.total)) * barWidth) / bar.total);
+
+        append(Cyan, fitToWidth(bar.description, room - barWidth));
+        if (barWidth > 0) {
+            append({}, " [");
+            std::string done;
+            for (int i = 0; i < filled; ++i) {
+                done += "█";
+            }
+            std::string remaining;
+            for (int i = filled; i < barWidth; ++i) {
+                remaining += "░";
             }
+            append(Green, done);
+            append(Dim, remaining);
+            append({}, "] ");
+            append({}, stats);
         }
-        m_stream << "] " << percent << "%\r";
     } else {
         // Indeterminate progress (spinner-like)
         static const char *spinChars = "⠋⠙⠹⠸⠼⠴⠦⠧⠇⠏";
         // Each spinner char is 3 bytes in UTF-8
-        int idx = (current % 10) * 3;
-        m_stream << rang::fg::cyan << std::string_view(spinChars + idx, 3)
-                 << " " << description << rang::fg::reset << "\r";
+        int idx = (bar.current % 10) * 3;
+        // Raw text from the daemon (e.g. Incus download_progress) replaces the description
+        const std::string_view label = bar.text.empty() ? bar.description : bar.text;
+        const int statsRoom = stats.empty() ? 0 : statsWidth + 2;
+        append(Cyan, std::string(spinChars + idx, 3) + " " + fitToWidth(label, available - 2 - statsRoom));
+        if (!stats.empty()) {
+            append({}, "  " + stats);
+        }
     }
-    m_stream.flush();
+    return line;
+}
+
+void Output::drawProgress(bool force)
+{
+    const Terminal term = terminal();
+    if (term == Terminal::None) {
+        return;
+    }
+
+    const auto now = std::chrono::steady_clock::now();
+    if (!force && m_drawnLines > 0 && now - m_lastFrame < std::chrono::milliseconds(1000 / ProgressFrameRate)) {
+        return;
+    }
+    m_lastFrame = now;
+    readTerminalSize();
+
+    std::string frame = "\r";
+    int width = 0;
+    if (term == Terminal::Dumb) {
+        // Single line: the oldest bar, padded over whatever was there
+        if (!m_bars.empty()) {
+            frame += renderBar(m_bars.front(), false, width);
+        }
+        if (width < m_drawnWidth) {
+            frame.append(m_drawnWidth - width, ' ');
+        }
+        writeFrame(frame);
+        m_drawnLines = m_bars.empty() ? 0 : 1;
+        m_drawnWidth = width;
+        return;
+    }
+
+    // Move back to the first bar line and redraw the stack in place. Lines
+    // that scrolled off the top can't be reached again, so the stack is
+    // kept shorter than the terminal.
+    if (m_drawnLines > 1) {
+        frame += "\x1b[" + std::to_string(m_drawnLines - 1) + "A";
+    }
+    const int lines = std::min(static_cast<int>(m_bars.size()), std::max(1, m_rows - 1));
+    for (int i = 0; i < lines; ++i) {
+        if (i > 0) {
+            frame += '\n';
+        }
+        frame += renderBar(m_bars[static_cast<size_t>(i)], true, width);
+        frame += EraseLine;
+    }
+    frame += EraseBelow;
+    writeFrame(frame);
+    m_drawnLines = lines;
+}
+
+void Output::clearProgress()
+{
+    if (m_drawnLines == 0) {
+        return;
+    }
+    if (terminal() == Terminal::Ansi) {
+        std::string frame = "\r";
+        if (m_drawnLines > 1) {
+            frame += "\x1b[" + std::to_string(m_drawnLines - 1) + "A";
+        }
+        frame += EraseBelow;
+        writeFrame(frame);
+    } else {
+        writeFrame("\r" + std::string(m_drawnWidth, ' ') + "\r");
+    }
+    m_drawnLines = 0;
+    m_drawnWidth = 0;
+}
+
+void Output::startProgress(std::string_view id, std::string_view description, int total)
+{
+    ProgressBar bar{std::string(id), std::string(description), {}, 0, total, 0.0, m_indentLevel};
+    auto it = std::find_if(m_bars.begin(), m_bars.end(), [id](const ProgressBar &b) {
+        return b.id == id;
+    });
+    if (it != m_bars.end()) {
+        *it = std::move(bar);
+    } else {
+        m_bars.push_back(std::move(bar));
+    }
+    drawProgress(true);
 }
 
-void Output::progressComplete(std::string_view message)
+void Output::updateProgress(std::string_view id, int current, double rate)
 {
-    // Clear the progress line (overwrite with spaces, then carriage return)
-    m_stream << "\r" << std::string(80, ' ') << "\r";
+    auto it = std::find_if(m_bars.begin(), m_bars.end(), [id](const ProgressBar &b) {
+        return b.id == id;
+    });
+    if (it == m_bars.end()) {
+        return;
+    }
+    it->current = current;
+    it->rate = rate;
+    drawProgress(false);
+}
+
+void Output::setProgressText(std::string_view id, std::string_view text)
+{
+    auto it = std::find_if(m_bars.begin(), m_bars.end(), [id](const ProgressBar &b) {
+        return b.id == id;
+    });
+    if (it != m_bars.end()) {
+        // Drawn with the next position update
+        it->text = text;
+    }
+}
+
+void Output::completeProgress(std::string_view id, std::string_view message)
+{
+    auto it = std::find_if(m_bars.begin(), m_bars.end(), [id](const ProgressBar &b) {
+        return b.id == id;
+    });
+    if (it == m_bars.end()) {
+        return;
+    }
+    const int barIndent = it->indent;
+    m_bars.erase(it);
+
+    clearProgress();
     if (!message.empty()) {
-        printPrefix();
-        m_stream << message << '\n';
+        const int savedIndent = m_indentLevel;
+        m_indentLevel = barIndent;
+        info(message);
+        m_indentLevel = savedIndent;
     }
     m_stream.flush();
+    if (!m_bars.empty()) {
+        drawProgress(true);
+    }
 }
 
 void Output::indent(int spaces)
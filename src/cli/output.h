@@ -8,9 +8,12 @@
 
 #include <Kapsule/Types>
 
+#include <chrono>
 #include <iostream>
+#include <optional>
 #include <string>
 #include <string_view>
+#include <vector>
 
 namespace Kapsule {
 
@@ -88,18 +91,47 @@ public:
     void print(MessageType type, std::string_view msg, int extraIndent = 0);
 
     /**
-     * @brief Print a progress indicator.
+     * @brief Start showing a progress bar.
+     *
+     * Bars are drawn on stderr at the current indentation, below all
+     * other output. On a terminal with escape sequences every live bar
+     * gets its own line, in the order the bars were started; with
+     * TERM=dumb only the oldest live bar is shown. Nothing is drawn when
+     * stderr is not a terminal.
+     *
+     * Starting a bar with the id of a live bar restarts it.
+     *
+     * @param id Identifies the bar in later calls
      * @param description What's being tracked
-     * @param current Current progress value
      * @param total Total value (-1 for indeterminate)
      */
-    void progress(std::string_view description, int current, int total = -1);
+    void startProgress(std::string_view id, std::string_view description, int total = -1);
+
+    /**
+     * @brief Move a progress bar.
+     *
+     * Redraws are capped at ProgressFrameRate per second.
+     *
+     * @param id The bar passed to startProgress()
+     * @param current Current progress value
+     * @param rate Bytes per second, shown with an ETA when positive
+     */
+    void updateProgress(std::string_view id, int current, double rate = 0.0);
 
     /**
-     * @brief Complete a progress bar, clearing the line.
-     * @param message Optional message to display after clearing (e.g., success/failure)
+     * @brief Show raw text instead of the description of an indeterminate bar.
      */
-    void progressComplete(std::string_view message = "");
+    void setProgressText(std::string_view id, std::string_view text);
+
+    /**
+     * @brief Remove a progress bar.
+     *
+     * The message, if any, is printed above the remaining bars, so
+     * completed bars leave their lines in the order they finished.
+     *
+     * @param message Optional message to display (e.g., success/failure)
+     */
+    void completeProgress(std::string_view id, std::string_view message = "");
 
     /**
      * @brief Increase indentation level.
@@ -116,14 +148,47 @@ public:
      */
     [[nodiscard]] int indentLevel() const { return m_indentLevel; }
 
+    /// Maximum number of progress frames drawn per second.
+    static constexpr int ProgressFrameRate = 15;
+
 private:
     friend Output &out();
     Output() = default;
 
+    enum class Terminal {
+        None, ///< Not a terminal: progress is not drawn
+        Dumb, ///< No escape sequences: plain text, cleared with spaces
+        Ansi,
+    };
+
+    struct ProgressBar {
+        std::string id;
+        std::string description;
+        std::string text; ///< Raw text shown by indeterminate bars
+        int current = 0;
+        int total = -1;
+        double rate = 0.0;
+        int indent = 0;
+    };
+
     void printPrefix(int extraIndent = 0);
+    [[nodiscard]] Terminal terminal();
+    void readTerminalSize();
+    [[nodiscard]] std::string renderBar(const ProgressBar &bar, bool ansi, int &width) const;
+    void drawProgress(bool force);
+    void clearProgress();
+    void writeFrame(std::string_view frame);
 
     std::ostream &m_stream = std::cerr;
     int m_indentLevel = 0;
+
+    std::optional<Terminal> m_terminal;
+    int m_columns = 80;
+    int m_rows = 24;
+    std::vector<ProgressBar> m_bars;
+    int m_drawnLines = 0; ///< Bar lines currently on screen
+    int m_drawnWidth = 0; ///< Columns used by the visible line (TERM=dumb)
+    std::chrono::steady_clock::time_point m_lastFrame;
 };
 
 /**
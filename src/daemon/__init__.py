@@ -7,7 +7,7 @@
 Provides container management services over D-Bus.
 """
 
-__version__ = "0.2.1"
+__version__ = "0.3.0"
 
 from .container import ContainerService
 from .operations import (
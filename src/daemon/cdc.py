@@ -0,0 +1,104 @@
+# SPDX-FileCopyrightText: 2026 Lasath Fernando <devel@lasath.org>
+#
+# SPDX-License-Identifier: GPL-3.0-or-later
+
+"""Content-defined chunking of kapsule image rootfs files.
+
+A gear hash (as in FastCDC) picks chunk boundaries from the data itself,
+so an insertion early in the file only changes the chunks around it
+instead of shifting every fixed-size block after it.  Consecutive builds
+of the same image share most of their squashfs data blocks, so clients
+that already hold the previous build only fetch the changed chunks.
+
+This module is the only definition of the chunker: the image server
+(``images/generate-simplestreams.py``) and the daemon
+(:mod:`.chunk_store`) both import it, since a locally indexed image
+only shares chunks with a published one if both cut at the same
+offsets.  It depends on numpy alone so the image scripts can load it
+without the rest of the daemon.
+"""
+
+from __future__ import annotations
+
+import hashlib
+import mmap
+
+import numpy as np
+
+CHUNK_MIN_SIZE = 64 * 1024
+CHUNK_AVG_BITS = 18  # 256 KiB average
+CHUNK_MAX_SIZE = 1024 * 1024
+CHUNK_INDEX_VERSION = 1
+
+# Bytes hashed per numpy pass.  The gear table lookup and the shifted
+# copy make each pass use about 16 times this in memory, which
+# matters inside the system daemon; the per-call overhead is negligible
+# at this size.  The boundaries don't depend on it.
+HASH_BLOCK_SIZE = 1024 * 1024
+
+_CHUNK_MASK = (1 << CHUNK_AVG_BITS) - 1
+_GEAR = np.array(
+    [
+        int.from_bytes(hashlib.sha256(bytes([i])).digest()[:8], "little")
+        for i in range(256)
+    ],
+    dtype=np.uint64,
+)
+_GEAR_WINDOW = 64
+
+
+def _gear_cut_candidates(data: bytes | mmap.mmap, block_size: int) -> np.ndarray:
+    """Return every offset whose 64-byte gear hash satisfies the cut mask.
+
+    The gear hash ``h = (h << 1) + gear[byte]`` forgets a byte after 64
+    steps, so at offset i it equals sum(gear[data[i - k]] << k) for
+    k < 64.  That sum is built for a whole block at once by doubling the
+    window: h_2w(i) = h_w(i) + (h_w(i - w) << w).
+    """
+    length = len(data)
+    candidates: list[np.ndarray] = []
+    for block_start in range(0, length, block_size):
+        # Include the preceding window so the first offsets see 64 bytes
+        lead = min(block_start, _GEAR_WINDOW - 1)
+        first = block_start - lead
+        count = min(block_start + block_size, length) - first
+        block = np.frombuffer(data, dtype=np.uint8, count=count, offset=first)
+        h = _GEAR[block]
+        shifted = np.empty_like(h)
+        width = 1
+        while width < min(_GEAR_WINDOW, count):
+            n = count - width
+            np.left_shift(h[:n], np.uint64(width), out=shifted[:n])
+            np.add(h[width:], shifted[:n], out=h[width:])
+            width *= 2
+        np.right_shift(h, np.uint64(40), out=h)
+        np.bitwise_and(h, np.uint64(_CHUNK_MASK), out=h)
+        hits = np.flatnonzero(h == 0)
+        candidates.append(hits[hits >= lead] + first)
+    if not candidates:
+        return np.empty(0, dtype=np.int64)
+    return np.concatenate(candidates)
+
+
+def chunk_boundaries(
+    data: bytes | mmap.mmap, block_size: int = HASH_BLOCK_SIZE
+) -> list[int]:
+    """Return the end offsets of the content-defined chunks of *data*.
+
+    A chunk ends after the first byte at least CHUNK_MIN_SIZE into it
+    whose gear hash has the mask bits clear, or at CHUNK_MAX_SIZE.
+    *block_size* only trades memory for numpy call overhead.
+    """
+    candidates = _gear_cut_candidates(data, block_size)
+    ends: list[int] = []
+    start = 0
+    length = len(data)
+    while start < length:
+        end = min(start + CHUNK_MAX_SIZE, length)
+        cut = end
+        i = int(np.searchsorted(candidates, start + CHUNK_MIN_SIZE))
+        if i < len(candidates) and candidates[i] < end:
+            cut = int(candidates[i]) + 1
+        ends.append(cut)
+        start = cut
+    return ends
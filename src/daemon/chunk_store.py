@@ -0,0 +1,474 @@
+# SPDX-FileCopyrightText: 2026 Lasath Fernando <devel@lasath.org>
+#
+# SPDX-License-Identifier: GPL-3.0-or-later
+
+"""Incremental download of kapsule images from content-addressed chunks.
+
+``images/generate-simplestreams.py`` splits every ``rootfs.squashfs``
+into content-defined chunks, uploads them under ``chunks/<sha[:2]>/<sha>``
+on the image server and publishes a chunk index next to the image (a
+``kapsule.chunks`` item in ``images.json``).  Consecutive builds share
+most of their chunks.
+
+The local chunk store does not keep a second copy of every image:
+Incus already has the rootfs of each cached image on disk, so we only
+keep a chunk index per cached image and read chunks straight out of
+``/var/lib/incus/images/<fingerprint>.rootfs``.  Images we assembled
+ourselves keep the published index; any other cached rootfs is chunked
+locally the first time it could contribute chunks, with the same
+chunker (:mod:`.cdc`) as the server.  A new build is then assembled
+from the chunks we already have plus the ones that changed, which are
+the only ones downloaded.
+
+Chunking, hashing and assembling touch the whole rootfs, so all file
+work runs in worker threads to keep the D-Bus loop responsive.  For
+background refreshes those threads run at idle CPU and I/O priority.
+"""
+
+from __future__ import annotations
+
+import asyncio
+import ctypes
+import functools
+import hashlib
+import logging
+import mmap
+import os
+import platform
+import threading
+from collections.abc import Callable
+from concurrent.futures import ThreadPoolExecutor
+from pathlib import Path
+from typing import TYPE_CHECKING, NamedTuple, TypeVar
+
+import httpx
+from pydantic import BaseModel, ValidationError
+
+from .cdc import CHUNK_INDEX_VERSION, chunk_boundaries
+
+if TYPE_CHECKING:
+    from .operations import OperationReporter
+
+logger = logging.getLogger(__name__)
+
+CHUNK_INDEX_FTYPE = "kapsule.chunks"
+
+_STATE_DIR = Path(os.environ.get("STATE_DIRECTORY", "/var/lib/kapsule"))
+_INCUS_IMAGES_DIR = Path("/var/lib/incus/images")
+
+# Number of chunks downloaded concurrently.
+_FETCH_CONCURRENCY = 8
+
+# ioprio_set() has no libc or Python wrapper, so it is called by number.
+_SYS_IOPRIO_SET = {"x86_64": 251, "aarch64": 30, "riscv64": 30}
+_IOPRIO_WHO_PROCESS = 1
+_IOPRIO_CLASS_IDLE = 3
+_IOPRIO_CLASS_SHIFT = 13
+
+_T = TypeVar("_T")
+
+
+def _lower_thread_priority() -> None:
+    """Move the calling thread to the lowest CPU and idle I/O priority.
+
+    Both are per-thread on Linux when given the thread id, so the rest
+    of the daemon keeps its normal priority.
+    """
+    tid = threading.get_native_id()
+    try:
+        os.setpriority(os.PRIO_PROCESS, tid, 19)
+    except OSError as e:
+        logger.debug("Could not lower CPU priority of thread %d: %s", tid, e)
+    number = _SYS_IOPRIO_SET.get(platform.machine())
+    if number is None:
+        return
+    libc = ctypes.CDLL(None, use_errno=True)
+    ioprio = _IOPRIO_CLASS_IDLE << _IOPRIO_CLASS_SHIFT
+    if libc.syscall(number, _IOPRIO_WHO_PROCESS, tid, ioprio) != 0:
+        logger.debug(
+            "Could not lower I/O priority of thread %d: %s",
+            tid,
+            os.strerror(ctypes.get_errno()),
+        )
+
+
+# Worker threads for background refreshes.  Their priority is lowered
+# once when they start, so they are never shared with interactive work.
+_background_executor = ThreadPoolExecutor(
+    max_workers=_FETCH_CONCURRENCY,
+    thread_name_prefix="kapsule-idle",
+    initializer=_lower_thread_priority,
+)
+
+
+async def _run_in_thread(
+    background: bool, func: Callable[..., _T], *args: object
+) -> _T:
+    """Run blocking file work off the event loop.
+
+    Background work goes to the low-priority threads, anything else to
+    the default executor like ``asyncio.to_thread``.
+    """
+    if not background:
+        return await asyncio.to_thread(func, *args)
+    loop = asyncio.get_running_loop()
+    return await loop.run_in_executor(
+        _background_executor, functools.partial(func, *args)
+    )
+
+
+# ---------------------------------------------------------------------------
+# Wire formats
+# ---------------------------------------------------------------------------
+
+
+class ChunkRef(BaseModel):
+    """One chunk of a chunked file, in file order."""
+
+    sha256: str
+    size: int
+
+
+class ChunkIndex(BaseModel):
+    """Chunk index published next to a ``rootfs.squashfs``."""
+
+    version: int
+    size: int
+    sha256: str
+    chunk_path: str = "chunks"
+    chunks: list[ChunkRef]
+
+
+class _StreamItem(BaseModel):
+    ftype: str
+    path: str
+    sha256: str | None = None
+    size: int | None = None
+    combined_squashfs_sha256: str | None = None
+
+
+class _StreamVersion(BaseModel):
+    items: dict[str, _StreamItem]
+
+
+class _StreamProduct(BaseModel):
+    aliases: str = ""
+    versions: dict[str, _StreamVersion]
+    requirements: dict[str, str] = {}
+
+
+class _StreamImages(BaseModel):
+    products: dict[str, _StreamProduct]
+
+
+class PublishedImage(NamedTuple):
+    """The latest chunked build of an image on a server."""
+
+    server: str
+    fingerprint: str
+    meta_item: _StreamItem
+    index_item: _StreamItem
+    requirements: dict[str, str]
+
+
+class ChunkedImage(NamedTuple):
+    """A split image assembled from chunks, ready for ``import_image``."""
+
+    meta_path: Path
+    rootfs_path: Path
+    chunk_index: ChunkIndex
+
+
+# ---------------------------------------------------------------------------
+# Store
+# ---------------------------------------------------------------------------
+
+
+class ChunkStore:
+    """Content-addressed view of the chunks already present on disk."""
+
+    def __init__(
+        self,
+        root: Path = _STATE_DIR / "chunks",
+        incus_images_dir: Path = _INCUS_IMAGES_DIR,
+    ) -> None:
+        self._index_dir = root / "indexes"
+        self._incus_images_dir = incus_images_dir
+
+    def save_index(self, fingerprint: str, index: ChunkIndex) -> None:
+        """Remember the chunk layout of a cached image's rootfs."""
+        self._index_dir.mkdir(parents=True, exist_ok=True)
+        path = self._index_dir / f"{fingerprint}.json"
+        path.write_text(index.model_dump_json())
+
+    def forget(self, fingerprint: str) -> None:
+        """Drop the chunk index of an image that is no longer cached."""
+        (self._index_dir / f"{fingerprint}.json").unlink(missing_ok=True)
+
+    def _unindexed_images(self) -> list[Path]:
+        """Return cached rootfs files that have no chunk index yet."""
+        try:
+            rootfs_files = list(self._incus_images_dir.glob("*.rootfs"))
+        except OSError:
+            return []
+        return [
+            rootfs
+            for rootfs in rootfs_files
+            if not (self._index_dir / f"{rootfs.stem}.json").exists()
+        ]
+
+    def _index_cached(self, rootfs: Path) -> None:
+        """Chunk a cached rootfs and save its index."""
+        try:
+            index = index_file(rootfs)
+        except (OSError, ValueError) as e:
+            # Empty or vanished image; it just won't contribute chunks.
+            logger.debug("Not indexing %s: %s", rootfs, e)
+            return
+        self.save_index(rootfs.stem, index)
+
+    def _local_chunks(self) -> dict[str, tuple[Path, int]]:
+        """Map chunk digest to (rootfs path, offset) for cached images."""
+        located: dict[str, tuple[Path, int]] = {}
+        if not self._index_dir.is_dir():
+            return located
+        for index_path in self._index_dir.glob("*.json"):
+            rootfs = self._incus_images_dir / f"{index_path.stem}.rootfs"
+            if not rootfs.is_file():
+                # Image was deleted behind our back.
+                index_path.unlink(missing_ok=True)
+                continue
+            try:
+                index = ChunkIndex.model_validate_json(index_path.read_text())
+            except (OSError, ValidationError):
+                continue
+            offset = 0
+            for chunk in index.chunks:
+                located.setdefault(chunk.sha256, (rootfs, offset))
+                offset += chunk.size
+        return located
+
+    async def lookup(self, server: str, alias: str) -> PublishedImage | None:
+        """Find the latest chunked build of *alias* on *server*.
+
+        Returns None if the server does not publish a chunk index for the
+        image, in which case the caller should fall back to a regular
+        Incus download.
+
+        Raises:
+            httpx.HTTPError: If the server can't be reached.
+        """
+        server = server.rstrip("/")
+        async with httpx.AsyncClient(timeout=60.0, follow_redirects=True) as client:
+            resp = await client.get(f"{server}/streams/v1/images.json")
+            resp.raise_for_status()
+            streams = _StreamImages.model_validate_json(resp.content)
+
+        found = _find_latest(streams, alias)
+        if found is None:
+            return None
+        product, items = found
+        meta_item = items.get("incus.tar.xz")
+        index_item = next(
+            (i for i in items.values() if i.ftype == CHUNK_INDEX_FTYPE), None
+        )
+        if meta_item is None or index_item is None:
+            return None
+        if not meta_item.combined_squashfs_sha256:
+            return None
+
+        return PublishedImage(
+            server=server,
+            fingerprint=meta_item.combined_squashfs_sha256,
+            meta_item=meta_item,
+            index_item=index_item,
+            requirements=product.requirements,
+        )
+
+    async def fetch(
+        self,
+        image: PublishedImage,
+        dest_dir: Path,
+        progress: OperationReporter,
+        *,
+        background: bool = False,
+    ) -> ChunkedImage:
+        """Assemble *image* in *dest_dir*, downloading only missing chunks.
+
+        With *background*, hashing and assembly run at idle CPU and I/O
+        priority.
+
+        Raises:
+            httpx.HTTPError: If a download fails.
+            ValueError: If downloaded data does not match its hash.
+        """
+        server = image.server
+        async with httpx.AsyncClient(timeout=60.0, follow_redirects=True) as client:
+            resp = await client.get(f"{server}/{image.index_item.path}")
+            resp.raise_for_status()
+            index = ChunkIndex.model_validate_json(resp.content)
+            if index.version != CHUNK_INDEX_VERSION:
+                raise ValueError(f"Unsupported chunk index version {index.version}")
+
+            meta_path = dest_dir / "incus.tar.xz"
+            resp = await client.get(f"{server}/{image.meta_item.path}")
+            resp.raise_for_status()
+            expected = image.meta_item.sha256
+            if expected and _sha256(resp.content) != expected:
+                raise ValueError("Checksum mismatch for incus.tar.xz")
+            meta_path.write_bytes(resp.content)
+
+            rootfs_path = dest_dir / "rootfs.squashfs"
+            await self._assemble(
+                client, server, index, rootfs_path, progress, background
+            )
+
+        return ChunkedImage(
+            meta_path=meta_path,
+            rootfs_path=rootfs_path,
+            chunk_index=index,
+        )
+
+    async def _assemble(
+        self,
+        client: httpx.AsyncClient,
+        server: str,
+        index: ChunkIndex,
+        rootfs_path: Path,
+        progress: OperationReporter,
+        background: bool,
+    ) -> None:
+        for rootfs in await _run_in_thread(background, self._unindexed_images):
+            progress.info(f"Indexing cached image {rootfs.stem[:12]}...")
+            await _run_in_thread(background, self._index_cached, rootfs)
+
+        local = await _run_in_thread(background, self._local_chunks)
+        sizes = {c.sha256: c.size for c in index.chunks}
+        missing = [d for d in sizes if d not in local]
+        progress.info(
+            f"Fetching {len(missing)}/{len(sizes)} unique chunks "
+            f"({sum(sizes[d] for d in missing) // (1024 * 1024)} of "
+            f"{index.size // (1024 * 1024)} MiB)"
+        )
+
+        # Downloaded chunks are spooled to disk next to the output rather
+        # than held in memory: on a first download that is the whole image.
+        spool = rootfs_path.parent / "chunks"
+        spool.mkdir(exist_ok=True)
+        semaphore = asyncio.Semaphore(_FETCH_CONCURRENCY)
+
+        async def download(digest: str) -> Path:
+            async with semaphore:
+                url = f"{server}/{index.chunk_path}/{digest[:2]}/{digest}"
+                resp = await client.get(url)
+                resp.raise_for_status()
+                return await _run_in_thread(
+                    background, _spool_chunk, spool, digest, resp.content
+                )
+
+        async with progress.track(
+            "Downloading changed chunks...", total=len(missing)
+        ) as bar:
+            pending = [asyncio.create_task(download(d)) for d in missing]
+            try:
+                for done, task in enumerate(asyncio.as_completed(pending), start=1):
+                    await task
+                    bar.update(done)
+            except BaseException:
+                for t in pending:
+                    t.cancel()
+                raise
+
+        loop = asyncio.get_running_loop()
+
+        def write_rootfs() -> str:
+            whole = hashlib.sha256()
+            with open(rootfs_path, "wb") as out:
+                for chunk in index.chunks:
+                    data: bytes | None = None
+                    if chunk.sha256 in local:
+                        data = _read_local(local[chunk.sha256], chunk)
+                    if data is None:
+                        spooled = spool / chunk.sha256
+                        if not spooled.exists():
+                            # Local copy didn't verify; fetch it after all.
+                            spooled = asyncio.run_coroutine_threadsafe(
+                                download(chunk.sha256), loop
+                            ).result()
+                        data = spooled.read_bytes()
+                    out.write(data)
+                    whole.update(data)
+            return whole.hexdigest()
+
+        if await _run_in_thread(background, write_rootfs) != index.sha256:
+            raise ValueError("Checksum mismatch for assembled rootfs")
+
+
+def _sha256(data: bytes) -> str:
+    return hashlib.sha256(data).hexdigest()
+
+
+def _spool_chunk(spool: Path, digest: str, data: bytes) -> Path:
+    if _sha256(data) != digest:
+        raise ValueError(f"Checksum mismatch for chunk {digest}")
+    path = spool / digest
+    path.write_bytes(data)
+    return path
+
+
+def index_file(path: Path) -> ChunkIndex:
+    """Build the chunk index of *path* without copying any chunks.
+
+    Blocks for as long as it takes to read and hash the whole file; run
+    it in a worker thread.
+
+    Raises:
+        OSError: If the file can't be read.
+        ValueError: If the file is empty.
+    """
+    chunks: list[ChunkRef] = []
+    whole = hashlib.sha256()
+    with (
+        open(path, "rb") as f,
+        mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ) as data,
+    ):
+        start = 0
+        for end in chunk_boundaries(data):
+            piece = data[start:end]
+            whole.update(piece)
+            chunks.append(ChunkRef(sha256=_sha256(piece), size=end - start))
+            start = end
+        size = len(data)
+    return ChunkIndex(
+        version=CHUNK_INDEX_VERSION,
+        size=size,
+        sha256=whole.hexdigest(),
+        chunks=chunks,
+    )
+
+
+def _read_local(location: tuple[Path, int], chunk: ChunkRef) -> bytes | None:
+    path, offset = location
+    try:
+        with open(path, "rb") as f:
+            f.seek(offset)
+            data = f.read(chunk.size)
+    except OSError:
+        return None
+    if len(data) != chunk.size or _sha256(data) != chunk.sha256:
+        return None
+    return data
+
+
+def _find_latest(
+    streams: _StreamImages, alias: str
+) -> tuple[_StreamProduct, dict[str, _StreamItem]] | None:
+    """Find the newest version of the product published under *alias*."""
+    for product in streams.products.values():
+        if alias not in product.aliases.split(","):
+            continue
+        if not product.versions:
+            return None
+        latest = max(product.versions)
+        return product, product.versions[latest].items
+    return None
@@ -13,6 +13,17 @@ This module handles configuration with systemd-style layered precedence:
 Configuration options:
 - default_container: Name of the default container to create/enter when none specified
 - default_image: Default image to use when creating new containers
+
+Daemon-wide settings live in the ``[refresh]`` section and are only read
+from the system paths (2 and 3), since they are not per-user:
+- enabled: Whether the background image refresh scheduler runs
+- interval: Minimum seconds between background refreshes of an image set
+- idle_delay: Seconds without daemon activity before a refresh may start
+- allow_metered: Whether to refresh over a metered network connection
+
+The ``[progress]`` section is read the same way:
+- max_rate: Maximum progress signals per second for each progress bar
+  (0 disables rate limiting)
 """
 
 import configparser
@@ -28,10 +39,32 @@ class KapsuleConfig(NamedTuple):
     default_image: str
 
 
+class RefreshConfig(NamedTuple):
+    """Daemon configuration for background image refreshes."""
+
+    enabled: bool
+    interval: int
+    idle_delay: int
+    allow_metered: bool
+
+
+class ProgressConfig(NamedTuple):
+    """Daemon configuration for operation progress signals."""
+
+    max_rate: float
+
+
 # Default values (used if no config files exist)
 DEFAULT_CONTAINER_NAME = "kapsule"
 DEFAULT_IMAGE = "images:ubuntu/24.04"
 
+DEFAULT_REFRESH_ENABLED = True
+DEFAULT_REFRESH_INTERVAL = 24 * 60 * 60
+DEFAULT_REFRESH_IDLE_DELAY = 10 * 60
+DEFAULT_REFRESH_ALLOW_METERED = False
+
+DEFAULT_PROGRESS_MAX_RATE = 10.0
+
 
 def get_config_paths(home_dir: str | None = None) -> list[Path]:
     """Get all config file paths in priority order (highest first).
@@ -115,6 +148,84 @@ def load_config(home_dir: str | None = None) -> KapsuleConfig:
     )
 
 
+def load_refresh_config() -> RefreshConfig:
+    """Load the background refresh settings from the system config paths.
+
+    The user config is skipped: the scheduler runs once for the whole
+    system, so only the admin and package defaults apply.  Invalid
+    values are ignored and fall back to the lower-priority setting.
+
+    Returns:
+        RefreshConfig with merged settings.
+    """
+    enabled = DEFAULT_REFRESH_ENABLED
+    interval = DEFAULT_REFRESH_INTERVAL
+    idle_delay = DEFAULT_REFRESH_IDLE_DELAY
+    allow_metered = DEFAULT_REFRESH_ALLOW_METERED
+
+    system_paths = get_config_paths()[1:]
+    for config_path in reversed(system_paths):
+        if not config_path.exists():
+            continue
+
+        parser = configparser.ConfigParser()
+        try:
+            parser.read(config_path)
+        except configparser.Error:
+            continue
+
+        if not parser.has_section("refresh"):
+            continue
+
+        try:
+            enabled = parser.getboolean("refresh", "enabled", fallback=enabled)
+            interval = parser.getint("refresh", "interval", fallback=interval)
+            idle_delay = parser.getint("refresh", "idle_delay", fallback=idle_delay)
+            allow_metered = parser.getboolean(
+                "refresh", "allow_metered", fallback=allow_metered
+            )
+        except ValueError:
+            # Skip malformed values, keeping whatever was parsed so far
+            continue
+
+    return RefreshConfig(
+        enabled=enabled,
+        interval=max(interval, 60),
+        idle_delay=max(idle_delay, 0),
+        allow_metered=allow_metered,
+    )
+
+
+def load_progress_config() -> ProgressConfig:
+    """Load the progress signal settings from the system config paths.
+
+    Like the refresh settings these apply to the whole daemon, so the
+    user config is skipped.
+
+    Returns:
+        ProgressConfig with merged settings.
+    """
+    max_rate = DEFAULT_PROGRESS_MAX_RATE
+
+    system_paths = get_config_paths()[1:]
+    for config_path in reversed(system_paths):
+        if not config_path.exists():
+            continue
+
+        parser = configparser.ConfigParser()
+        try:
+            parser.read(config_path)
+        except configparser.Error:
+            continue
+
+        try:
+            max_rate = parser.getfloat("progress", "max_rate", fallback=max_rate)
+        except ValueError:
+            continue
+
+    return ProgressConfig(max_rate=max(max_rate, 0.0))
+
+
 def save_config(config: KapsuleConfig) -> None:
     """Save user configuration to disk.
 
@@ -6,8 +6,12 @@
 
 from __future__ import annotations
 
+import asyncio
 import json
 import logging
+import os
+import time
+from pathlib import Path
 
 import httpx
 
@@ -50,16 +54,109 @@ def is_kapsule_server(url: str) -> bool:
     return url.startswith(_KAPSULE_S3_BASE + "/")
 
 
-async def resolve_server(alias: str) -> str:
+# How long a resolved kapsule server URL is served without revalidating.
+_KAPSULE_SERVER_TTL = 15 * 60
+
+# The last known good URL survives daemon restarts, so a create right
+# after boot doesn't have to wait for GitLab either.
+_KAPSULE_SERVER_STAMP = (
+    Path(os.environ.get("STATE_DIRECTORY", "/var/lib/kapsule")) / "kapsule-server"
+)
+
+
+class _KapsuleServerCache:
+    """Stale-while-revalidate cache for the resolved kapsule server URL.
+
+    A fresh URL is returned as is.  A stale one is returned immediately
+    while a background task resolves the new one, and if resolution
+    fails the last known good URL keeps being served.  Concurrent
+    callers share a single in-flight resolution.
+    """
+
+    def __init__(self) -> None:
+        self._url: str | None = None
+        self._resolved_at = 0.0
+        self._inflight: asyncio.Task[str] | None = None
+        self._loaded = False
+
+    async def get(self, *, fresh: bool = False) -> str:
+        self._load()
+        age = time.monotonic() - self._resolved_at
+
+        if self._url is not None and not fresh:
+            if age >= _KAPSULE_SERVER_TTL:
+                self._revalidate()
+            return self._url
+
+        try:
+            return await asyncio.shield(self._revalidate())
+        except Exception:
+            if self._url is None:
+                raise
+            log.warning("Using last known kapsule server %s", self._url)
+            return self._url
+
+    def _revalidate(self) -> asyncio.Task[str]:
+        if self._inflight is None or self._inflight.done():
+            self._inflight = asyncio.create_task(self._resolve())
+            self._inflight.add_done_callback(_log_resolve_failure)
+        return self._inflight
+
+    async def _resolve(self) -> str:
+        try:
+            url = await _resolve_kapsule_server()
+        except Exception:
+            # Back off for a TTL before retrying, serving the old URL.
+            self._resolved_at = time.monotonic()
+            raise
+        self._url = url
+        self._resolved_at = time.monotonic()
+        try:
+            _KAPSULE_SERVER_STAMP.parent.mkdir(parents=True, exist_ok=True)
+            _KAPSULE_SERVER_STAMP.write_text(url + "\n")
+        except OSError:
+            log.debug("Could not persist kapsule server URL", exc_info=True)
+        return url
+
+    def _load(self) -> None:
+        if self._loaded:
+            return
+        self._loaded = True
+        try:
+            url = _KAPSULE_SERVER_STAMP.read_text().strip()
+        except OSError:
+            return
+        if is_kapsule_server(url):
+            # Treat as stale so the first use revalidates it.
+            self._url = url
+            self._resolved_at = -_KAPSULE_SERVER_TTL
+
+
+def _log_resolve_failure(task: asyncio.Task[str]) -> None:
+    if not task.cancelled() and (exc := task.exception()) is not None:
+        log.warning("Could not resolve kapsule server: %s", exc)
+
+
+_kapsule_server_cache = _KapsuleServerCache()
+
+
+async def resolve_server(alias: str, *, fresh: bool = False) -> str:
     """Resolve a server alias to a URL.
 
     Static aliases are looked up in SERVER_MAP. The ``kapsule`` alias is
     resolved dynamically by querying the GitLab API for the latest
     successful build job and constructing the S3 URL for that job's
-    artifacts.
+    artifacts.  That lookup is cached (see ``_KapsuleServerCache``) so
+    it stays off the create path.
+
+    Args:
+        alias: Server alias, e.g. ``"images"`` or ``"kapsule"``.
+        fresh: Wait for an up-to-date kapsule URL instead of serving a
+            stale cached one.  Still falls back to the last known good
+            URL if GitLab can't be reached.
     """
     if alias == "kapsule":
-        return await _resolve_kapsule_server()
+        return await _kapsule_server_cache.get(fresh=fresh)
     url = SERVER_MAP.get(alias)
     if not url:
         raise OperationError(
@@ -16,23 +16,42 @@ a function with the pipeline's ``step`` decorator to register it.
 
 from __future__ import annotations
 
+import asyncio
 import contextlib
+import fnmatch
 import logging
 import os
 import pwd
+import re
 import subprocess
+import tempfile
+from collections.abc import Awaitable, Callable
 from pathlib import Path
 from typing import TYPE_CHECKING
 
-from ..config import load_config
-from ..incus_client import IncusClient, IncusError
-from ..models_generated import Image
+import httpx
+from dbus_fast import Variant
+from pydantic import ValidationError
+
+from ..chunk_store import ChunkStore
+from ..config import load_config, load_progress_config
+from ..incus_client import (
+    SOURCE_ALIAS_PROPERTY,
+    SOURCE_PROTOCOL_PROPERTY,
+    SOURCE_SERVER_PROPERTY,
+    IncusClient,
+    IncusError,
+    image_update_source,
+)
+from ..models_generated import Image, Instance, InstanceFull
 from ..operations import (
+    JOURNAL_PATH,
     NullOperationReporter,
     OperationError,
     OperationReporter,
     OperationTracker,
     operation,
+    resume_operations,
 )
 from ..progress_tracker import wait_operation_with_progress
 from .constants import (
@@ -55,6 +74,26 @@ if TYPE_CHECKING:
 
 logger = logging.getLogger(__name__)
 
+# Number of containers a bulk operation works on concurrently.
+_BULK_CONCURRENCY = 4
+
+# Fields of the D-Bus container tuple, in order.
+_CONTAINER_FIELDS = ("name", "status", "image", "created", "mode")
+
+# Integer values of Kapsule::Container::State and Kapsule::ContainerMode
+# in the v2 container tuple.  Unlisted statuses map to 0 (Unknown).
+_CONTAINER_STATES = {
+    "Stopped": 1,
+    "Starting": 2,
+    "Running": 3,
+    "Stopping": 4,
+    "Error": 5,
+}
+_CONTAINER_MODES = {"Default": 0, "Session": 1, "DbusMux": 2}
+
+# Config key pattern marking a host user as set up in a container.
+_USER_MAPPED_KEY = re.compile(r"user\.kapsule\.host-users\.(\d+)\.mapped")
+
 
 class ContainerService:
     """Container lifecycle operations exposed over D-Bus.
@@ -81,6 +120,10 @@ class ContainerService:
         self._incus = incus
         self._host_config_sync = host_config_sync
         self._tracker = OperationTracker()
+        self._tracker.set_progress_rate(load_progress_config().max_rate)
+        self._chunk_store = ChunkStore()
+        # Set once interrupted operations have been picked up again.
+        self._resumed = asyncio.Event()
 
         # Cache for runtime bind mounts.
         # Key: (container_name, uid)
@@ -96,10 +139,59 @@ class ContainerService:
         """
         self._tracker.set_bus(bus)
 
+    async def resume_operations(self) -> None:
+        """Restart the resumable operations the previous daemon left running.
+
+        Called once at startup, right after the daemon takes its bus name,
+        so that the resumed operations' signals come from the name clients
+        follow.  Clients that reconnect in between wait for it in
+        list_operations().
+        """
+        try:
+            entries = self._tracker.open_journal(JOURNAL_PATH)
+            await resume_operations(self, entries)
+        finally:
+            self._resumed.set()
+
+    async def list_running_operations(self) -> list[str]:
+        """List running operations once interrupted ones have resumed."""
+        await self._resumed.wait()
+        return self.list_operations()
+
     def list_operations(self) -> list[str]:
         """List D-Bus object paths of all running operations."""
         return self._tracker.list_paths()
 
+    def has_running_operations(self) -> bool:
+        """Whether any operation is currently in flight."""
+        return bool(self._tracker.list_all())
+
+    async def wait_for_operation(self, object_path: str) -> str:
+        """Wait for an operation started by this service to finish.
+
+        Used by internal callers (e.g. the background refresh scheduler)
+        that start an operation themselves and need to know when it is
+        done.
+
+        Returns:
+            The final status ("completed", "failed" or "cancelled"), or
+            "unknown" if the operation already finished and was forgotten.
+        """
+        op_id = object_path.rsplit("/", 1)[-1]
+        op = self._tracker.get(op_id)
+        if op is None:
+            return "unknown"
+        await asyncio.wait({op.task})
+        return op.interface.status()
+
+    def cancel_operation(self, object_path: str) -> bool:
+        """Cancel an operation started by this service.
+
+        Returns False if the operation already finished.
+        """
+        op = self._tracker.get(object_path.rsplit("/", 1)[-1])
+        return op is not None and op.interface.request_cancel()
+
     # -------------------------------------------------------------------------
     # Pipeline runners
     # -------------------------------------------------------------------------
@@ -181,7 +273,7 @@ class ContainerService:
         )
 
         progress.success(f"Container '{name}' created successfully")
-        self._interface.ContainersChanged()
+        await self._notify_changed(name)
 
     @operation(
         "delete",
@@ -202,6 +294,59 @@ class ContainerService:
             name: Container name
             force: Force removal even if running
         """
+        await self._delete_one(progress, name, force)
+        progress.success(f"Container '{name}' removed successfully")
+
+    @operation(
+        "start",
+        description="Starting container: {name}",
+        target_param="name",
+    )
+    async def start_container(
+        self,
+        progress: OperationReporter,
+        *,
+        name: str,
+    ) -> None:
+        """Start a stopped container.
+
+        Args:
+            progress: Operation reporter (auto-injected)
+            name: Container name
+        """
+        if not await self._start_one(progress, name):
+            progress.warning(f"Container '{name}' is already running")
+            return
+        progress.success(f"Container '{name}' started successfully")
+
+    @operation(
+        "stop",
+        description="Stopping container: {name}",
+        target_param="name",
+    )
+    async def stop_container(
+        self,
+        progress: OperationReporter,
+        *,
+        name: str,
+        force: bool = False,
+    ) -> None:
+        """Stop a running container.
+
+        Args:
+            progress: Operation reporter (auto-injected)
+            name: Container name
+            force: Force stop
+        """
+        if not await self._stop_one(progress, name, force):
+            progress.warning(f"Container '{name}' is not running")
+            return
+        progress.success(f"Container '{name}' stopped successfully")
+
+    async def _delete_one(
+        self, progress: OperationReporter, name: str, force: bool
+    ) -> None:
+        """Delete one container, stopping it first if *force* is set."""
         # Check existence
         if not await self._incus.instance_exists(name):
             raise OperationError(f"Container '{name}' does not exist")
@@ -232,33 +377,20 @@ class ContainerService:
         except IncusError as e:
             raise OperationError(f"Failed to delete container: {e}") from e
 
-        progress.success(f"Container '{name}' removed successfully")
-        self._interface.ContainersChanged()
+        self._notify_removed(name)
 
-    @operation(
-        "start",
-        description="Starting container: {name}",
-        target_param="name",
-    )
-    async def start_container(
-        self,
-        progress: OperationReporter,
-        *,
-        name: str,
-    ) -> None:
-        """Start a stopped container.
+    async def _start_one(self, progress: OperationReporter, name: str) -> bool:
+        """Start one container.
 
-        Args:
-            progress: Operation reporter (auto-injected)
-            name: Container name
+        Returns:
+            False if the container was already running, True otherwise.
         """
         if not await self._incus.instance_exists(name):
             raise OperationError(f"Container '{name}' does not exist")
 
         instance = await self._incus.get_instance(name)
         if instance.status and instance.status.lower() == "running":
-            progress.warning(f"Container '{name}' is already running")
-            return
+            return False
 
         raw_lxc = (instance.config or {}).get("raw.lxc", "")
         if NVIDIA_HOOK_PATH in raw_lxc:
@@ -272,35 +404,23 @@ class ContainerService:
         except IncusError as e:
             raise OperationError(f"Failed to start container: {e}") from e
 
-        progress.success(f"Container '{name}' started successfully")
-        self._interface.ContainersChanged()
+        await self._notify_changed(name)
+        return True
 
-    @operation(
-        "stop",
-        description="Stopping container: {name}",
-        target_param="name",
-    )
-    async def stop_container(
-        self,
-        progress: OperationReporter,
-        *,
-        name: str,
-        force: bool = False,
-    ) -> None:
-        """Stop a running container.
+    async def _stop_one(
+        self, progress: OperationReporter, name: str, force: bool
+    ) -> bool:
+        """Stop one container.
 
-        Args:
-            progress: Operation reporter (auto-injected)
-            name: Container name
-            force: Force stop
+        Returns:
+            False if the container was not running, True otherwise.
         """
         if not await self._incus.instance_exists(name):
             raise OperationError(f"Container '{name}' does not exist")
 
         instance = await self._incus.get_instance(name)
         if instance.status and instance.status.lower() != "running":
-            progress.warning(f"Container '{name}' is not running")
-            return
+            return False
 
         progress.info("Stopping container...")
         try:
@@ -310,8 +430,142 @@ class ContainerService:
         except IncusError as e:
             raise OperationError(f"Failed to stop container: {e}") from e
 
-        progress.success(f"Container '{name}' stopped successfully")
-        self._interface.ContainersChanged()
+        await self._notify_changed(name)
+        return True
+
+    # -------------------------------------------------------------------------
+    # Bulk Lifecycle Operations
+    # -------------------------------------------------------------------------
+
+    @operation(
+        "delete_many",
+        description="Removing containers: {names}",
+        target_param="names",
+    )
+    async def delete_containers(
+        self,
+        progress: OperationReporter,
+        *,
+        names: list[str],
+        force: bool = False,
+    ) -> None:
+        """Delete several containers in parallel.
+
+        Args:
+            progress: Operation reporter (auto-injected)
+            names: Container names
+            force: Force removal of running containers
+        """
+
+        async def delete(name: str) -> str:
+            await self._delete_one(NullOperationReporter(), name, force)
+            return "removed"
+
+        await self._run_bulk(progress, names, "Removing", "remove", delete)
+
+    @operation(
+        "start_many",
+        description="Starting containers: {names}",
+        target_param="names",
+    )
+    async def start_containers(
+        self,
+        progress: OperationReporter,
+        *,
+        names: list[str],
+    ) -> None:
+        """Start several containers in parallel.
+
+        Args:
+            progress: Operation reporter (auto-injected)
+            names: Container names
+        """
+
+        async def start(name: str) -> str:
+            started = await self._start_one(NullOperationReporter(), name)
+            return "started" if started else "already running"
+
+        await self._run_bulk(progress, names, "Starting", "start", start)
+
+    @operation(
+        "stop_many",
+        description="Stopping containers: {names}",
+        target_param="names",
+    )
+    async def stop_containers(
+        self,
+        progress: OperationReporter,
+        *,
+        names: list[str],
+        force: bool = False,
+    ) -> None:
+        """Stop several containers in parallel.
+
+        Args:
+            progress: Operation reporter (auto-injected)
+            names: Container names
+            force: Force stop
+        """
+
+        async def stop(name: str) -> str:
+            stopped = await self._stop_one(NullOperationReporter(), name, force)
+            return "stopped" if stopped else "not running"
+
+        await self._run_bulk(progress, names, "Stopping", "stop", stop)
+
+    async def _run_bulk(
+        self,
+        progress: OperationReporter,
+        names: list[str],
+        verb: str,
+        action_name: str,
+        action: Callable[[str], Awaitable[str]],
+    ) -> None:
+        """Run *action* on each container with bounded concurrency.
+
+        Every container gets its own progress bar while it is being
+        worked on, then a line with the string *action* returned or the
+        error it raised.  One container failing does not stop the
+        others; the operation fails at the end if any did.
+        """
+        names = list(dict.fromkeys(names))
+        if not names:
+            raise OperationError("No containers given")
+
+        semaphore = asyncio.Semaphore(_BULK_CONCURRENCY)
+        failed: list[str] = []
+
+        async def run_one(name: str) -> None:
+            async with semaphore:
+                bar = progress.start_progress(f"{verb} {name}...", indent=1)
+                try:
+                    result = await action(name)
+                except OperationError as e:
+                    bar.complete(False)
+                    failed.append(name)
+                    progress.error(str(e), indent=1)
+                except Exception as e:
+                    # An unexpected error (Incus API, I/O) in one container
+                    # must not abandon the others mid-operation.
+                    logger.exception("Bulk %s of %s failed", action_name, name)
+                    bar.complete(False)
+                    failed.append(name)
+                    progress.error(f"{name}: {e}", indent=1)
+                except BaseException:
+                    bar.complete(False)
+                    raise
+                else:
+                    bar.complete(True)
+                    progress.success(f"{name}: {result}", indent=1)
+
+        await asyncio.gather(*(run_one(name) for name in names))
+
+        if failed:
+            raise OperationError(
+                f"Failed to {action_name} {len(failed)} of {len(names)} "
+                f"containers: {', '.join(failed)}"
+            )
+        progress.success(f"{verb} {len(names)} containers done")
 
     # -------------------------------------------------------------------------
     # User Setup Operations
@@ -362,12 +616,14 @@ class ContainerService:
     @operation(
         "refresh_images",
         description="Refreshing cached images",
+        resumable=True,
     )
     async def refresh_images(
         self,
         progress: OperationReporter,
         *,
         image_spec: str,
+        background: bool = False,
     ) -> None:
         """Refresh cached images from their upstream sources.
 
@@ -382,6 +638,8 @@ class ContainerService:
             progress: Operation reporter (auto-injected)
             image_spec: Image filter in "server:alias" format, or empty
                 string to refresh all auto-update images.
+            background: Started by the idle-time scheduler rather than a
+                client; the chunk work then runs at idle priority.
         """
         # Parse the image_spec filter
         filter_server: str | None = None
@@ -390,19 +648,21 @@ class ContainerService:
         if image_spec:
             if ":" in image_spec:
                 server_alias, filter_alias = image_spec.split(":", 1)
-                filter_server = await resolve_server(server_alias)
+                filter_server = await resolve_server(server_alias, fresh=True)
             else:
                 # Bare alias — match any server with this alias
                 filter_alias = image_spec
 
         # List all cached images
-        all_images = await self._incus.list_images()
+        all_images = await self.list_images()
 
         # Filter to auto-update cached images
+        # Images the daemon assembled from chunks are imported rather
+        # than cached, and carry their upstream in properties instead.
         candidates = [
             img
             for img in all_images
-            if img.auto_update and img.cached and img.update_source
+            if img.auto_update and image_update_source(img) is not None
         ]
 
         if not candidates:
@@ -415,7 +675,7 @@ class ContainerService:
         # Use a prefix match for kapsule URLs instead.
         matched: list[Image] = []
         for img in candidates:
-            src = img.update_source
+            src = image_update_source(img)
             assert src is not None  # guarded by filter above
 
             if filter_server and src.server:
@@ -442,13 +702,13 @@ class ContainerService:
         # images can be re-downloaded from the latest build.
         kapsule_server: str | None = filter_server
         if kapsule_server is None and any(
-            img.update_source
-            and img.update_source.server
-            and is_kapsule_server(img.update_source.server)
+            (src := image_update_source(img))
+            and src.server
+            and is_kapsule_server(src.server)
             for img in matched
         ):
             try:
-                kapsule_server = await resolve_server("kapsule")
+                kapsule_server = await resolve_server("kapsule", fresh=True)
             except Exception:
                 logger.warning(
                     "Could not resolve latest kapsule server; "
@@ -458,7 +718,7 @@ class ContainerService:
 
         refreshed = 0
         for img in matched:
-            src = img.update_source
+            src = image_update_source(img)
             assert src is not None
             label = f"{src.alias} from {src.server}"
 
@@ -483,6 +743,28 @@ class ContainerService:
                     and is_kapsule_server(src.server)
                 )
 
+                # Kapsule builds published with a chunk index are assembled
+                # locally, reusing the chunks of the image we already have.
+                chunk_server = effective_server or src.server
+                if (
+                    (needs_redownload or img.update_source is None)
+                    and chunk_server
+                    and src.alias
+                    and is_kapsule_server(chunk_server)
+                    and await self._refresh_from_chunks(
+                        img, chunk_server, src.alias, progress, background
+                    )
+                ):
+                    progress.success(f"Refreshed: {label}")
+                    refreshed += 1
+                    continue
+
+                if img.update_source is None:
+                    # Imported from chunks earlier, so Incus has nothing to
+                    # refresh in place; fall back to a full download.
+                    needs_redownload = True
+                    effective_server = chunk_server
+
                 if needs_redownload:
                     assert src.alias is not None
                     assert src.protocol is not None
@@ -528,10 +810,78 @@ class ContainerService:
 
         progress.success(f"Refreshed {refreshed}/{len(matched)} image(s)")
 
+    async def _refresh_from_chunks(
+        self,
+        img: Image,
+        server: str,
+        alias: str,
+        progress: OperationReporter,
+        background: bool,
+    ) -> bool:
+        """Replace *img* with the latest build assembled from chunks.
+
+        Only the chunks that are not already part of a cached image are
+        downloaded.  The result is imported as a local image that records
+        its upstream in ``kapsule.source.*`` properties, so later
+        refreshes and ``create`` still recognise it.
+
+        Returns:
+            False if the server has no chunked build or fetching failed,
+            so the caller should fall back to a regular download.
+        """
+        assert img.fingerprint is not None
+        try:
+            published = await self._chunk_store.lookup(server, alias)
+        except (httpx.HTTPError, ValidationError) as e:
+            logger.info("No chunk index for %s on %s: %s", alias, server, e)
+            return False
+        if published is None:
+            return False
+        if published.fingerprint == img.fingerprint:
+            progress.dim(f"{alias} is already up to date")
+            return True
+
+        progress.info(f"New kapsule build detected, updating {alias} from chunks")
+        with tempfile.TemporaryDirectory(dir="/var/tmp", prefix="kapsule-") as tmp:
+            try:
+                chunked = await self._chunk_store.fetch(
+                    published, Path(tmp), progress, background=background
+                )
+            except (httpx.HTTPError, ValidationError, ValueError) as e:
+                progress.warning(f"Chunked download failed, falling back: {e}")
+                return False
+            fingerprint = await self._incus.import_image(
+                chunked.meta_path, chunked.rootfs_path, aliases=[]
+            )
+
+        properties = {
+            SOURCE_SERVER_PROPERTY: published.server,
+            SOURCE_PROTOCOL_PROPERTY: "simplestreams",
+            SOURCE_ALIAS_PROPERTY: alias,
+        }
+        # Incus turns simplestreams requirements into these properties on
+        # a normal pull; read_image_defaults relies on them.
+        for key, value in published.requirements.items():
+            properties[f"requirements.{key}"] = value
+        await self._incus.update_image(
+            fingerprint, auto_update=True, properties=properties
+        )
+        self._chunk_store.save_index(fingerprint, chunked.chunk_index)
+
+        # The old image was the source of the reused chunks, so it can
+        # only go once the new one is in place.
+        aliases = [a.name for a in img.aliases or [] if a.name]
+        await self._incus.delete_image(img.fingerprint)
+        self._chunk_store.forget(img.fingerprint)
+        for local_alias in aliases:
+            await self._incus.create_image_alias(local_alias, fingerprint)
+        return True
+
     @operation(
         "import_image",
         description="Importing image: {alias}",
         target_param="alias",
+        resumable=True,
     )
     async def import_image(
         self,
@@ -584,11 +934,28 @@ class ContainerService:
     async def list_images(self) -> list[Image]:
         """List all images.
 
+        Served from the image index when one is attached to the Incus
+        client, so repeated listings don't each hit the REST API.
+
         Returns:
             List of Image objects from the Incus API
         """
+        index = self._incus.image_index
+        if index is not None:
+            return await index.all()
         return await self._incus.list_images()
 
+    async def list_image_summaries(
+        self,
+    ) -> list[tuple[str, list[str], str, int, str]]:
+        """List all images with just the fields clients display.
+
+        Returns:
+            List of (fingerprint, aliases, description, size, uploaded)
+            tuples
+        """
+        return [_image_tuple(image) for image in await self.list_images()]
+
     @operation(
         "delete_image",
         description="Deleting image: {identifier}",
@@ -635,24 +1002,86 @@ class ContainerService:
         Returns:
             List of (name, status, image, created, kapsule_mode) tuples
         """
-        containers = await self._incus.list_containers()
-        result: list[tuple[str, str, str, str, str]] = []
-        for c in containers:
-            # Get kapsule mode from instance config
-            try:
-                instance = await self._incus.get_instance(c.name)
-                config = instance.config or {}
-                if config.get(KAPSULE_DBUS_MUX_KEY) == "true":
-                    mode = "DbusMux"
-                elif config.get(KAPSULE_SESSION_MODE_KEY) == "true":
-                    mode = "Session"
-                else:
-                    mode = "Default"
-            except IncusError:
-                mode = "unknown"
+        # recursion=1 already carries each instance's config, so the mode
+        # comes from the same response instead of one GET per container.
+        instances = await self._incus.list_instances(recursion=1)
+        return [_container_tuple(instance) for instance in instances]
+
+    async def list_containers_v2(
+        self,
+    ) -> list[tuple[str, int, str, int, int, dict[str, Variant]]]:
+        """List all containers in the compact v2 wire format.
+
+        Returns:
+            List of (name, state, image, created, mode, extra) tuples;
+            see ``DBusContainerV2``.
+        """
+        # The init PID is part of the instance state, which recursion=1
+        # leaves out.
+        instances = await self._incus.list_instance_states()
+        return [_container_tuple_v2(instance) for instance in instances]
+
+    async def query_containers(
+        self,
+        *,
+        states: list[str],
+        name: str = "",
+        image: str = "",
+        fields: list[str],
+    ) -> list[tuple[str, str, str, str, str]]:
+        """List the containers matching a filter.
+
+        The state filter is evaluated by Incus, so containers in other
+        states are never loaded.  When nothing beyond the name (and the
+        status, for a single requested state) is needed, Incus returns
+        bare instance URLs instead of full objects.
 
-            result.append((c.name, c.status, c.image, c.created, mode))
-        return result
+        Args:
+            states: Incus status names (e.g. "Running"); empty for any.
+            name: Shell-style glob the name must match; empty for any.
+            image: Image description the container must have; empty
+                for any.
+            fields: Fields to fill in besides the name, out of
+                ``status``, ``image``, ``created`` and ``mode``; empty
+                for all.  The others are returned as empty strings.
+
+        Returns:
+            List of (name, status, image, created, kapsule_mode) tuples
+        """
+        unknown = set(fields) - set(_CONTAINER_FIELDS)
+        if unknown:
+            raise OperationError(
+                f"Unknown container fields: {', '.join(sorted(unknown))}"
+            )
+        # Status names go into the Incus filter expression verbatim.
+        if not all(state.isalpha() for state in states):
+            raise OperationError(f"Invalid container states: {', '.join(states)}")
+
+        wanted = set(fields or _CONTAINER_FIELDS)
+        status_filter = " or ".join(f"status eq {state}" for state in states)
+
+        cheap = {"name", "status"} if len(states) == 1 else {"name"}
+        if not image and wanted <= cheap:
+            status = states[0] if "status" in wanted else ""
+            return [
+                (instance_name, status, "", "", "")
+                for instance_name in await self._incus.list_instance_names(
+                    status_filter
+                )
+                if not name or fnmatch.fnmatchcase(instance_name, name)
+            ]
+
+        containers: list[tuple[str, str, str, str, str]] = []
+        for instance in await self._incus.list_instances(
+            recursion=1, filter=status_filter
+        ):
+            row = _container_tuple(instance)
+            if name and not fnmatch.fnmatchcase(row[0], name):
+                continue
+            if image and row[2] != image:
+                continue
+            containers.append(_project(row, wanted))
+        return containers
 
     async def get_container_info(self, name: str) -> tuple[str, str, str, str, str]:
         """Get container information.
@@ -668,25 +1097,55 @@ class ContainerService:
         except IncusError as e:
             raise OperationError(f"Container '{name}' not found: {e}") from e
 
-        config = instance.config or {}
+        return _container_tuple(instance, name)
 
-        # Determine kapsule mode
-        if config.get(KAPSULE_DBUS_MUX_KEY) == "true":
-            mode = "DbusMux"
-        elif config.get(KAPSULE_SESSION_MODE_KEY) == "true":
-            mode = "Session"
-        else:
-            mode = "Default"
+    async def container_stats(
+        self, names: list[str]
+    ) -> list[tuple[str, int, int, int, int, int, int, int, int]]:
+        """Sample resource usage of running containers.
 
-        image = config.get("image.description", config.get("image.os", "unknown"))
+        All states come from one Incus request, so polling this for
+        every running container costs the same as polling one.
 
-        return (
-            instance.name or name,
-            instance.status or "Unknown",
-            image,
-            instance.created_at.isoformat() if instance.created_at else "",
-            mode,
-        )
+        Args:
+            names: Containers to report; empty for all running ones.
+                Containers that are not running are left out.
+
+        Returns:
+            List of (name, cpu_time, memory_usage, memory_limit,
+            swap_usage, disk_usage, bytes_received, bytes_sent,
+            processes) tuples
+        """
+        instances = await self._incus.list_running_instance_states()
+        wanted = set(names)
+        return [
+            _stats_tuple(instance)
+            for instance in instances
+            if not wanted or instance.name in wanted
+        ]
+
+    # -------------------------------------------------------------------------
+    # Change notifications
+    # -------------------------------------------------------------------------
+
+    async def _notify_changed(self, name: str) -> None:
+        """Broadcast the new state of *name* after a lifecycle operation.
+
+        Subscribers apply the ``ContainerUpdated`` delta to their local
+        copy of the list instead of calling ``ListContainers`` again.
+        """
+        try:
+            info = await self.get_container_info(name)
+        except OperationError:
+            logger.debug("Could not read back container %s", name, exc_info=True)
+        else:
+            self._interface.ContainerUpdated(*info)
+        self._interface.ContainersChanged()
+
+    def _notify_removed(self, name: str) -> None:
+        """Broadcast that *name* no longer exists."""
+        self._interface.ContainerRemoved(name)
+        self._interface.ContainersChanged()
 
     async def is_user_setup(self, container_name: str, uid: int) -> bool:
         """Check if a user is already set up in a container.
@@ -1092,3 +1551,119 @@ class ContainerService:
             ],
             capture_output=True,
         )
+
+
+def _container_mode(config: dict[str, str]) -> str:
+    """Kapsule D-Bus mode recorded in an instance's config."""
+    if config.get(KAPSULE_DBUS_MUX_KEY) == "true":
+        return "DbusMux"
+    if config.get(KAPSULE_SESSION_MODE_KEY) == "true":
+        return "Session"
+    return "Default"
+
+
+def _container_tuple(
+    instance: Instance, name: str = ""
+) -> tuple[str, str, str, str, str]:
+    """D-Bus (name, status, image, created, mode) tuple for an instance."""
+    config = instance.config or {}
+    image = config.get("image.description", config.get("image.os", "unknown"))
+    return (
+        instance.name or name,
+        instance.status or "Unknown",
+        image,
+        instance.created_at.isoformat() if instance.created_at else "",
+        _container_mode(config),
+    )
+
+
+def _container_tuple_v2(
+    instance: InstanceFull,
+) -> tuple[str, int, str, int, int, dict[str, Variant]]:
+    """D-Bus compact (name, state, image, created, mode, extra) tuple."""
+    config = instance.config or {}
+    image = config.get("image.description", config.get("image.os", "unknown"))
+    status = instance.status or "Unknown"
+
+    extra: dict[str, Variant] = {}
+    if status == "Running" and instance.last_used_at:
+        extra["started_at"] = Variant("x", int(instance.last_used_at.timestamp()))
+    if status == "Running" and instance.state and instance.state.pid:
+        extra["pid"] = Variant("x", instance.state.pid)
+    setup_users = [
+        int(match.group(1))
+        for key, value in config.items()
+        if value == "true" and (match := _USER_MAPPED_KEY.fullmatch(key))
+    ]
+    if setup_users:
+        extra["setup_users"] = Variant("au", sorted(setup_users))
+
+    return (
+        instance.name or "",
+        _CONTAINER_STATES.get(status, 0),
+        image,
+        int(instance.created_at.timestamp()) if instance.created_at else 0,
+        _CONTAINER_MODES[_container_mode(config)],
+        extra,
+    )
+
+
+def _project(
+    row: tuple[str, str, str, str, str], fields: set[str]
+) -> tuple[str, str, str, str, str]:
+    """Blank the fields of a container tuple that were not asked for."""
+    name, status, image, created, mode = row
+    return (
+        name,
+        status if "status" in fields else "",
+        image if "image" in fields else "",
+        created if "created" in fields else "",
+        mode if "mode" in fields else "",
+    )
+
+
+def _stats_tuple(
+    instance: InstanceFull,
+) -> tuple[str, int, int, int, int, int, int, int, int]:
+    """D-Bus resource usage tuple for a running instance.
+
+    CPU time is cumulative nanoseconds; clients derive a percentage
+    from two samples.  Disk usage is summed over the instance's disks
+    and network counters over all interfaces except loopback.
+    """
+    state = instance.state
+    if state is None:
+        return (instance.name or "", 0, 0, 0, 0, 0, 0, 0, 0)
+
+    cpu = state.cpu
+    memory = state.memory
+    disk_usage = sum(disk.usage or 0 for disk in (state.disk or {}).values())
+    received = sent = 0
+    for interface, network in (state.network or {}).items():
+        if interface == "lo" or network.counters is None:
+            continue
+        received += network.counters.bytes_received or 0
+        sent += network.counters.bytes_sent or 0
+
+    return (
+        instance.name or "",
+        (cpu.usage or 0) if cpu else 0,
+        (memory.usage or 0) if memory else 0,
+        (memory.total or 0) if memory else 0,
+        (memory.swap_usage or 0) if memory else 0,
+        disk_usage,
+        received,
+        sent,
+        state.processes or 0,
+    )
+
+
+def _image_tuple(image: Image) -> tuple[str, list[str], str, int, str]:
+    """D-Bus (fingerprint, aliases, description, size, uploaded) tuple."""
+    return (
+        image.fingerprint or "",
+        [alias.name for alias in image.aliases or [] if alias.name],
+        (image.properties or {}).get("description", ""),
+        image.size or 0,
+        image.uploaded_at.isoformat() if image.uploaded_at else "",
+    )
@@ -76,6 +76,47 @@ DBusContainerList = Annotated[
 ]
 """List of container info tuples"""
 
+DBusContainerV2 = Annotated[
+    tuple[str, int, str, int, int, dict[str, object]],
+    DBusSignature("(sisxia{sv})"),
+    CppType("Kapsule::ContainerV2"),
+]
+"""Compact container info tuple: (name, state, image, created, mode, extra).
+
+State and mode are the integer values of Kapsule::Container::State and
+Kapsule::ContainerMode, created is a Unix timestamp (0 if unknown), and
+extra holds optional fields such as ``started_at`` (x), ``pid`` (x)
+and ``setup_users`` (au)."""
+
+DBusContainerListV2 = Annotated[
+    list[tuple[str, int, str, int, int, dict[str, object]]],
+    DBusSignature("a(sisxia{sv})"),
+    CppType("QList<Kapsule::ContainerV2>"),
+]
+"""List of compact container info tuples"""
+
+DBusImage = Annotated[
+    tuple[str, list[str], str, int, str],
+    DBusSignature("(sassxs)"),
+    CppType("Kapsule::Image"),
+]
+"""Image info tuple: (fingerprint, aliases, description, size, uploaded)"""
+
+DBusImageList = Annotated[
+    list[tuple[str, list[str], str, int, str]],
+    DBusSignature("a(sassxs)"),
+    CppType("QList<Kapsule::Image>"),
+]
+"""List of image info tuples"""
+
+DBusContainerStats = Annotated[
+    list[tuple[str, int, int, int, int, int, int, int, int]],
+    DBusSignature("a(sxxxxxxxi)"),
+    CppType("QList<Kapsule::ContainerStats>"),
+]
+"""List of container resource usage tuples: (name, cpu_time, memory_usage,
+memory_limit, swap_usage, disk_usage, bytes_received, bytes_sent, processes)"""
+
 DBusEnterResult = Annotated[
     tuple[bool, str, list[str]],
     DBusSignature("(bsas)"),
@@ -92,7 +133,12 @@ __all__ = [
     # Kapsule composite types
     "DBusContainer",
     "DBusContainerList",
+    "DBusContainerListV2",
+    "DBusContainerStats",
+    "DBusContainerV2",
     "DBusEnterResult",
+    "DBusImage",
+    "DBusImageList",
     # Metadata
     "CppType",
 ]
@@ -0,0 +1,233 @@
+# SPDX-FileCopyrightText: 2026 Lasath Fernando <devel@lasath.org>
+#
+# SPDX-License-Identifier: GPL-3.0-or-later
+
+"""In-memory index of the local Incus image store.
+
+Image lookups on the create path used to list every image over REST and
+scan them for a matching ``update_source``.  This index keeps the image
+list in memory, keyed by fingerprint, by local alias and by upstream
+``(server, alias)``, so those checks are dictionary lookups.
+
+The index follows the Incus lifecycle event stream
+(``/1.0/events?type=lifecycle``) for changes made by anyone, and the
+Incus client updates it directly after the daemon's own image calls so
+there is no window where our own change is not yet visible.  While the
+event stream is down the index is not trusted and every lookup falls
+back to a fresh listing.
+"""
+
+from __future__ import annotations
+
+import asyncio
+import contextlib
+import json
+import logging
+from typing import cast
+
+from websockets.asyncio.client import unix_connect
+from websockets.exceptions import ConnectionClosed, InvalidHandshake
+
+from .incus_client import IncusClient, IncusError, image_update_source
+from .models_generated import Image
+
+logger = logging.getLogger(__name__)
+
+_IMAGES_PREFIX = "/1.0/images/"
+_ALIASES_PREFIX = "/1.0/images/aliases/"
+
+# Reconnect backoff for the lifecycle event stream, in seconds.
+_RECONNECT_MIN = 1.0
+_RECONNECT_MAX = 60.0
+
+
+class ImageIndex:
+    """Cached view of the Incus image store with O(1) lookups."""
+
+    def __init__(self, incus: IncusClient) -> None:
+        self._incus = incus
+        self._by_fingerprint: dict[str, Image] = {}
+        self._by_alias: dict[str, str] = {}
+        self._by_source: dict[tuple[str, str], str] = {}
+        self._live = False
+        self._task: asyncio.Task[None] | None = None
+
+    # ------------------------------------------------------------------
+    # Lifecycle
+    # ------------------------------------------------------------------
+
+    def start(self) -> None:
+        """Start following the Incus lifecycle event stream."""
+        if self._task is None:
+            self._task = asyncio.create_task(self._watch(), name="image-index")
+
+    async def stop(self) -> None:
+        """Stop following events; lookups fall back to REST afterwards."""
+        self._live = False
+        if self._task is None:
+            return
+        self._task.cancel()
+        with contextlib.suppress(asyncio.CancelledError):
+            await self._task
+        self._task = None
+
+    @property
+    def live(self) -> bool:
+        """Whether the index is loaded and kept current by events."""
+        return self._live
+
+    # ------------------------------------------------------------------
+    # Lookups
+    # ------------------------------------------------------------------
+
+    async def all(self) -> list[Image]:
+        """All images in the local store."""
+        if not self._live:
+            await self._reload_all()
+        return list(self._by_fingerprint.values())
+
+    async def find_by_source(self, server: str, alias: str) -> Image | None:
+        """Find the cached image pulled from *alias* on *server*."""
+        if not self._live:
+            await self._reload_all()
+        fingerprint = self._by_source.get((server, alias))
+        if fingerprint is None:
+            return None
+        return self._by_fingerprint.get(fingerprint)
+
+    async def find_by_alias(self, alias: str) -> Image | None:
+        """Find the image a local alias points to."""
+        if not self._live:
+            await self._reload_all()
+        fingerprint = self._by_alias.get(alias)
+        if fingerprint is None:
+            return None
+        return self._by_fingerprint.get(fingerprint)
+
+    def get(self, fingerprint: str) -> Image | None:
+        """Get an indexed image by fingerprint, without any REST call."""
+        return self._by_fingerprint.get(fingerprint)
+
+    # ------------------------------------------------------------------
+    # Updates
+    # ------------------------------------------------------------------
+
+    async def reload(self, fingerprint: str) -> None:
+        """Re-read one image from Incus, e.g. after the daemon changed it."""
+        try:
+            image = await self._incus.get_image(fingerprint)
+        except IncusError as e:
+            if e.code == 404:
+                self.discard(fingerprint)
+                return
+            raise
+        self._put(image)
+
+    def discard(self, fingerprint: str) -> None:
+        """Drop an image that no longer exists."""
+        image = self._by_fingerprint.pop(fingerprint, None)
+        if image is None:
+            return
+        for key in [k for k, v in self._by_alias.items() if v == fingerprint]:
+            del self._by_alias[key]
+        for key in [k for k, v in self._by_source.items() if v == fingerprint]:
+            del self._by_source[key]
+
+    def _put(self, image: Image) -> None:
+        fingerprint = image.fingerprint
+        if not fingerprint:
+            return
+        self.discard(fingerprint)
+        self._by_fingerprint[fingerprint] = image
+        for alias in image.aliases or []:
+            if alias.name:
+                self._by_alias[alias.name] = fingerprint
+        source = image_update_source(image)
+        if source and source.server and source.alias:
+            self._by_source[(source.server, source.alias)] = fingerprint
+
+    async def _reload_all(self) -> None:
+        images = await self._incus.list_images()
+        self._by_fingerprint.clear()
+        self._by_alias.clear()
+        self._by_source.clear()
+        for image in images:
+            self._put(image)
+
+    # ------------------------------------------------------------------
+    # Event stream
+    # ------------------------------------------------------------------
+
+    async def _watch(self) -> None:
+        delay = _RECONNECT_MIN
+        while True:
+            try:
+                async with unix_connect(
+                    path=self._incus.socket_path,
+                    uri="ws://localhost/1.0/events?type=lifecycle",
+                    proxy=None,
+                    user_agent_header=None,
+                    open_timeout=10,
+                    ping_interval=20,
+                    ping_timeout=20,
+                ) as websocket:
+                    # Subscribe first, then load, so nothing that happens
+                    # in between is missed.
+                    await self._reload_all()
+                    self._live = True
+                    delay = _RECONNECT_MIN
+                    logger.debug(
+                        "Image index loaded (%d images)", len(self._by_fingerprint)
+                    )
+                    async for message in websocket:
+                        await self._handle_event(message)
+            except (OSError, ConnectionClosed, InvalidHandshake, TimeoutError):
+                logger.debug("Incus lifecycle event stream unavailable", exc_info=True)
+            except Exception:
+                logger.warning("Image index watcher failed", exc_info=True)
+
+            self._live = False
+            await asyncio.sleep(delay)
+            delay = min(delay * 2, _RECONNECT_MAX)
+
+    async def _handle_event(self, message: str | bytes) -> None:
+        text = (
+            message.decode("utf-8", errors="replace")
+            if isinstance(message, bytes)
+            else message
+        )
+        try:
+            event_raw = json.loads(text)
+        except json.JSONDecodeError:
+            return
+        if not isinstance(event_raw, dict):
+            return
+        event = cast(dict[str, object], event_raw)
+        metadata = event.get("metadata")
+        if not isinstance(metadata, dict):
+            return
+        metadata_dict = cast(dict[str, object], metadata)
+
+        action = metadata_dict.get("action")
+        source = metadata_dict.get("source")
+        if not isinstance(action, str) or not isinstance(source, str):
+            return
+        if not action.startswith("image-"):
+            return
+        path = source.split("?", 1)[0]
+
+        try:
+            if path.startswith(_ALIASES_PREFIX):
+                # Alias changes can move an alias between images, which
+                # is cheapest to pick up by reloading the whole list.
+                await self._reload_all()
+            elif path.startswith(_IMAGES_PREFIX):
+                fingerprint = path[len(_IMAGES_PREFIX) :]
+                if action == "image-deleted":
+                    self.discard(fingerprint)
+                else:
+                    await self.reload(fingerprint)
+        except Exception:
+            # Can't trust the index any more; resync from scratch.
+            logger.warning("Failed to apply image event %s", action, exc_info=True)
+            await self._reload_all()
@@ -0,0 +1,315 @@
+# SPDX-FileCopyrightText: 2026 Lasath Fernando <devel@lasath.org>
+#
+# SPDX-License-Identifier: GPL-3.0-or-later
+
+"""Background refresh of cached auto-update images.
+
+Without this, images only get refreshed when the user runs
+``kapsule image refresh``, and the first ``create`` after an upstream
+rebuild pays for the whole download.  The scheduler periodically runs
+the regular ``refresh_images`` operation for all auto-update images,
+but only when it is unlikely to get in the way:
+
+* the configured interval since the last refresh has passed,
+* nobody has talked to the daemon for ``idle_delay`` seconds and no
+  other operation is in flight (so interactive enters never wait),
+* logind reports the seat as idle (or, when logind has no opinion,
+  the system load is low), and
+* NetworkManager does not report a metered connection, unless the
+  admin allowed it.
+
+Pacing keeps the refresh cheap: one image at a time, only while the
+machine is idle.  Kapsule images are assembled from chunks by the daemon
+itself, and for a background refresh that work (indexing cached images,
+verifying and writing chunks) runs on threads at idle CPU and I/O
+priority.  Plain Incus downloads run inside incusd, which is shared with
+interactive requests and keeps its priority.
+A running background refresh is cancelled as soon as someone creates,
+starts or enters a container, and tried again at the next idle period.
+Only a successful refresh counts towards the interval; after a failure
+the next attempt is backed off from ``_RETRY_DELAY``.
+"""
+
+from __future__ import annotations
+
+import asyncio
+import contextlib
+import logging
+import os
+import time
+from pathlib import Path
+from typing import TYPE_CHECKING
+
+from dbus_fast import Message, MessageType, Variant
+from dbus_fast.aio import MessageBus
+
+from .config import RefreshConfig
+
+if TYPE_CHECKING:
+    from .container import ContainerService
+
+logger = logging.getLogger(__name__)
+
+_LOGIN_BUS = "org.freedesktop.login1"
+_LOGIN_PATH = "/org/freedesktop/login1"
+_LOGIN_INTERFACE = "org.freedesktop.login1.Manager"
+
+_NM_BUS = "org.freedesktop.NetworkManager"
+_NM_PATH = "/org/freedesktop/NetworkManager"
+_NM_INTERFACE = "org.freedesktop.NetworkManager"
+
+# NMMetered values that mean "this connection costs money".
+_NM_METERED_YES = 1
+_NM_METERED_GUESS_YES = 3
+
+_PROPS_INTERFACE = "org.freedesktop.DBus.Properties"
+
+# How often the scheduler wakes up to re-check its conditions.
+_CHECK_INTERVAL = 60.0
+
+# First delay before retrying a failed refresh; doubles with each
+# further failure, up to the configured interval.
+_RETRY_DELAY = 15 * 60.0
+
+# Method calls that mean someone is waiting on the daemon right now, so
+# a background refresh should get out of the way.
+_INTERACTIVE_METHODS = frozenset(
+    {
+        "CreateContainer",
+        "PrepareEnter",
+        "StartContainer",
+        "StartContainers",
+        "ImportImage",
+    }
+)
+
+# Without an idle hint, only start when the 1-minute load average per
+# CPU is below this.
+_LOW_LOAD_PER_CPU = 0.5
+
+# systemd sets STATE_DIRECTORY from StateDirectory= in the unit.
+_STATE_DIR = Path(os.environ.get("STATE_DIRECTORY", "/var/lib/kapsule"))
+_STAMP_FILE = _STATE_DIR / "last-image-refresh"
+
+
+async def _get_property(
+    bus: MessageBus,
+    service: str,
+    path: str,
+    interface: str,
+    property_name: str,
+) -> Variant | None:
+    """Read a D-Bus property, returning None if the service can't answer."""
+    reply = await bus.call(
+        Message(
+            destination=service,
+            path=path,
+            interface=_PROPS_INTERFACE,
+            member="Get",
+            signature="ss",
+            body=[interface, property_name],
+        )
+    )
+    if reply.message_type == MessageType.ERROR:
+        return None
+    result: Variant = reply.body[0]
+    return result
+
+
+def _system_load_is_low() -> bool:
+    try:
+        load_1m = os.getloadavg()[0]
+    except OSError:
+        return True
+    return load_1m < _LOW_LOAD_PER_CPU * (os.cpu_count() or 1)
+
+
+class ImageRefreshScheduler:
+    """Periodically refresh auto-update images while the system is idle."""
+
+    def __init__(
+        self,
+        bus: MessageBus,
+        container_service: ContainerService,
+        config: RefreshConfig,
+    ) -> None:
+        self._bus = bus
+        self._service = container_service
+        self._config = config
+        self._task: asyncio.Task[None] | None = None
+        self._last_activity = time.monotonic()
+        self._last_refresh = self._read_stamp()
+        self._failures = 0
+        self._retry_at = 0.0
+        # Object path of the background refresh in flight, if any
+        self._current: str | None = None
+
+    # ------------------------------------------------------------------
+    # Public API
+    # ------------------------------------------------------------------
+
+    def start(self) -> None:
+        """Start the scheduler loop (no-op if disabled in config)."""
+        if not self._config.enabled:
+            logger.info("Background image refresh disabled in config")
+            return
+        self._task = asyncio.create_task(self._run(), name="image-refresh")
+        logger.info(
+            "Background image refresh every %ds (idle delay %ds)",
+            self._config.interval,
+            self._config.idle_delay,
+        )
+
+    async def stop(self) -> None:
+        """Stop the scheduler loop.
+
+        A refresh operation that is already running is left to finish on
+        its own; only the scheduling loop is cancelled.
+        """
+        if self._task is None:
+            return
+        self._task.cancel()
+        with contextlib.suppress(asyncio.CancelledError):
+            await self._task
+        self._task = None
+
+    def note_activity(self, member: str) -> None:
+        """Record that a client just used the daemon.
+
+        Called for every incoming method call so that a refresh never
+        starts while someone is actively creating or entering containers,
+        and a refresh that already started is cancelled when they do.
+
+        Args:
+            member: Name of the method being called
+        """
+        self._last_activity = time.monotonic()
+        if (
+            self._current is not None
+            and member in _INTERACTIVE_METHODS
+            and self._service.cancel_operation(self._current)
+        ):
+            logger.info("Cancelling background image refresh for %s", member)
+
+    # ------------------------------------------------------------------
+    # Scheduling
+    # ------------------------------------------------------------------
+
+    async def _run(self) -> None:
+        while True:
+            await asyncio.sleep(_CHECK_INTERVAL)
+            try:
+                if await self._should_refresh():
+                    await self._refresh()
+            except Exception:
+                logger.warning("Background image refresh check failed", exc_info=True)
+
+    async def _should_refresh(self) -> bool:
+        since_refresh = time.time() - self._last_refresh
+        if since_refresh < self._config.interval:
+            return False
+        if time.time() < self._retry_at:
+            return False
+
+        if time.monotonic() - self._last_activity < self._config.idle_delay:
+            return False
+        if self._service.has_running_operations():
+            return False
+
+        # If logind says someone is at the keyboard, still refresh once
+        # we're a full interval overdue, so desktops that never report
+        # idle don't stay stale forever.
+        idle = await self._session_idle()
+        if idle is False and since_refresh < 2 * self._config.interval:
+            return False
+        if not _system_load_is_low():
+            return False
+
+        if not self._config.allow_metered and await self._connection_metered():
+            logger.debug("Skipping background image refresh on metered connection")
+            return False
+
+        return True
+
+    async def _refresh(self) -> None:
+        logger.info("Starting background image refresh")
+        object_path = await self._service.refresh_images(
+            image_spec="", background=True
+        )
+        self._current = object_path
+        try:
+            status = await self._service.wait_for_operation(object_path)
+        finally:
+            self._current = None
+
+        if status == "completed":
+            self._failures = 0
+            self._last_refresh = time.time()
+            self._write_stamp()
+            logger.info("Background image refresh finished")
+        elif status == "cancelled":
+            # Interrupted for an interactive client; the idle delay
+            # keeps it from restarting while they are busy.
+            logger.info("Background image refresh cancelled, will retry when idle")
+        else:
+            self._failures += 1
+            delay = min(self._config.interval, _RETRY_DELAY * 2 ** (self._failures - 1))
+            self._retry_at = time.time() + delay
+            logger.warning(
+                "Background image refresh %s, retrying in %ds", status, delay
+            )
+
+    # ------------------------------------------------------------------
+    # System state probes
+    # ------------------------------------------------------------------
+
+    async def _session_idle(self) -> bool | None:
+        """Ask logind whether all sessions are idle.
+
+        Returns None if logind is not available.
+        """
+        try:
+            variant = await _get_property(
+                self._bus, _LOGIN_BUS, _LOGIN_PATH, _LOGIN_INTERFACE, "IdleHint"
+            )
+        except Exception:
+            return None
+        if variant is None:
+            return None
+        idle: bool = variant.value
+        return idle
+
+    async def _connection_metered(self) -> bool:
+        """Ask NetworkManager whether the primary connection is metered.
+
+        Returns False if NetworkManager is not available, since there is
+        no other reliable way to tell.
+        """
+        try:
+            variant = await _get_property(
+                self._bus, _NM_BUS, _NM_PATH, _NM_INTERFACE, "Metered"
+            )
+        except Exception:
+            return False
+        if variant is None:
+            return False
+        metered: int = variant.value
+        return metered in (_NM_METERED_YES, _NM_METERED_GUESS_YES)
+
+    # ------------------------------------------------------------------
+    # Persistence
+    # ------------------------------------------------------------------
+
+    @staticmethod
+    def _read_stamp() -> float:
+        try:
+            return float(_STAMP_FILE.read_text().strip())
+        except (OSError, ValueError):
+            return 0.0
+
+    def _write_stamp(self) -> None:
+        try:
+            _STATE_DIR.mkdir(parents=True, exist_ok=True)
+            _STAMP_FILE.write_text(f"{self._last_refresh}\n")
+        except OSError:
+            logger.warning("Could not record last image refresh time", exc_info=True)
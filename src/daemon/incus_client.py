@@ -11,7 +11,8 @@ communicating over the Unix socket at /var/lib/incus/unix.socket.
 from __future__ import annotations
 
 from pathlib import Path
-from typing import Any, TypeVar
+from typing import TYPE_CHECKING, Any, TypeVar
+from urllib.parse import urlencode
 
 import httpx
 from pydantic import BaseModel, RootModel
@@ -20,9 +21,12 @@ from .models_generated import (
     Image,
     ImageAliasesEntry,
     ImageAliasesPost,
+    ImagePut,
+    ImageSource,
     ImagesPost,
     ImagesPostSource,
     Instance,
+    InstanceFull,
     InstancesPost,
     InstanceState,
     InstanceStatePut,
@@ -33,6 +37,9 @@ from .models_generated import (
     StoragePoolsPost,
 )
 
+if TYPE_CHECKING:
+    from .image_index import ImageIndex
+
 T = TypeVar("T", bound=BaseModel)
 
 
@@ -43,6 +50,12 @@ class InstanceList(RootModel[list[Instance]]):
     pass
 
 
+class InstanceFullList(RootModel[list[InstanceFull]]):
+    """List of InstanceFull objects (instances with their state)."""
+
+    pass
+
+
 class StringList(RootModel[list[str]]):
     """List of string URLs/paths."""
 
@@ -98,6 +111,45 @@ class ContainerInfo(BaseModel):
     created: str
 
 
+# Image properties recording where a locally assembled image came from.
+# Images imported from chunks have no Incus ``update_source``, so these
+# stand in for it (see ``image_update_source``).
+SOURCE_SERVER_PROPERTY = "kapsule.source.server"
+SOURCE_PROTOCOL_PROPERTY = "kapsule.source.protocol"
+SOURCE_ALIAS_PROPERTY = "kapsule.source.alias"
+
+
+def image_update_source(image: Image) -> ImageSource | None:
+    """Get the upstream source of a cached image.
+
+    Returns Incus' own ``update_source`` for images it pulled itself,
+    or one rebuilt from the ``kapsule.source.*`` properties for images
+    the daemon assembled from chunks and imported.
+    """
+    if image.update_source is not None:
+        return image.update_source
+    props = image.properties or {}
+    server = props.get(SOURCE_SERVER_PROPERTY)
+    alias = props.get(SOURCE_ALIAS_PROPERTY)
+    if not server or not alias:
+        return None
+    return ImageSource(
+        server=server,
+        alias=alias,
+        protocol=props.get(SOURCE_PROTOCOL_PROPERTY, "simplestreams"),
+        certificate=None,
+        image_type=None,
+    )
+
+
+def _instances_query(recursion: int, filter: str) -> str:
+    """Build a ``/1.0/instances`` request path."""
+    params: dict[str, str | int] = {"recursion": recursion}
+    if filter:
+        params["filter"] = filter
+    return f"/1.0/instances?{urlencode(params)}"
+
+
 # Module-level singleton instance
 _client: IncusClient | None = None
 
@@ -116,12 +168,26 @@ class IncusClient:
     def __init__(self, socket_path: str = "/var/lib/incus/unix.socket"):
         self._socket_path = socket_path
         self._client: httpx.AsyncClient | None = None
+        self._image_index: ImageIndex | None = None
 
     @property
     def socket_path(self) -> str:
         """Path to the Incus Unix socket."""
         return self._socket_path
 
+    @property
+    def image_index(self) -> ImageIndex | None:
+        """In-memory image index, if the daemon attached one."""
+        return self._image_index
+
+    def set_image_index(self, index: ImageIndex) -> None:
+        """Attach an image index to serve image lookups from memory.
+
+        The client keeps the index current after its own image calls;
+        changes made by others arrive through the index's event stream.
+        """
+        self._image_index = index
+
     async def _get_client(self) -> httpx.AsyncClient:
         """Get or create the HTTP client."""
         if self._client is None or self._client.is_closed:
@@ -217,23 +283,78 @@ class IncusClient:
     # High-level instance operations
     # -------------------------------------------------------------------------
 
-    async def list_instances(self, recursion: int = 1) -> list[Instance]:
+    async def list_instances(
+        self, recursion: int = 1, filter: str = ""
+    ) -> list[Instance]:
         """List all instances (containers and VMs).
 
         Args:
             recursion: 0 returns just URLs, 1 returns full objects.
+            filter: Incus filter expression (e.g. ``status eq Running``),
+                applied by Incus before the instances are loaded.
 
         Returns:
             List of Instance objects.
         """
         if recursion == 0:
-            # Just URLs like ["/1.0/instances/foo", "/1.0/instances/bar"]
-            # We'd need to fetch each one - not implemented yet
+            # Just URLs like ["/1.0/instances/foo", "/1.0/instances/bar"];
+            # use list_instance_names() for those.
             raise NotImplementedError("recursion=0 not yet supported")
 
         # With recursion=1, we get full instance objects
         result = await self._request(
-            "GET", f"/1.0/instances?recursion={recursion}", response_type=InstanceList
+            "GET",
+            _instances_query(recursion, filter),
+            response_type=InstanceList,
+        )
+        return result.root
+
+    async def list_instance_names(self, filter: str = "") -> list[str]:
+        """List instance names without loading the instances.
+
+        Args:
+            filter: Incus filter expression, as for list_instances().
+
+        Returns:
+            Instance names.
+        """
+        result = await self._request(
+            "GET", _instances_query(0, filter), response_type=StringList
+        )
+        return [url.rsplit("/", 1)[-1] for url in result.root]
+
+    async def list_instance_states(self) -> list[InstanceFull]:
+        """List all instances together with their basic runtime state.
+
+        ``recursion=2`` fills in each instance's state; the empty
+        ``fields`` selection leaves out its disk and network parts,
+        which are the costly ones to gather.
+
+        Returns:
+            List of InstanceFull objects with ``state`` populated, except
+            for the disk and network usage.
+        """
+        result = await self._request(
+            "GET",
+            "/1.0/instances?recursion=2;fields=",
+            response_type=InstanceFullList,
+        )
+        return result.root
+
+    async def list_running_instance_states(self) -> list[InstanceFull]:
+        """List running instances together with their live state.
+
+        Uses ``recursion=2`` so Incus returns every instance's state
+        (CPU, memory, disk, network, processes) in a single request
+        instead of one ``/state`` call per instance.
+
+        Returns:
+            List of InstanceFull objects with ``state`` populated.
+        """
+        result = await self._request(
+            "GET",
+            "/1.0/instances?recursion=2&filter=status+eq+Running",
+            response_type=InstanceFullList,
         )
         return result.root
 
@@ -379,6 +500,27 @@ class IncusClient:
             timeout=timeout + 30,
         )
 
+    async def cancel_operation(self, operation_id: str) -> None:
+        """Cancel a running operation.
+
+        Only operations that Incus marks as cancellable (image downloads,
+        for example) can be cancelled; others are rejected with an error.
+
+        Args:
+            operation_id: Operation UUID.
+
+        Raises:
+            IncusError: If Incus refused to cancel the operation.
+        """
+        client = await self._get_client()
+        response = await client.delete(f"/1.0/operations/{operation_id}")
+
+        if response.status_code >= 400:
+            raise IncusError(
+                f"Failed to cancel operation '{operation_id}': {response.text}",
+                response.status_code,
+            )
+
     async def instance_exists(self, name: str) -> bool:
         """Check if an instance exists.
 
@@ -953,6 +1095,9 @@ class IncusClient:
         for alias in aliases:
             await self.create_image_alias(alias, fingerprint)
 
+        if self._image_index is not None:
+            await self._image_index.reload(fingerprint)
+
         return fingerprint
 
     async def create_image_alias(self, alias: str, fingerprint: str) -> None:
@@ -980,6 +1125,42 @@ class IncusClient:
                 response.status_code,
             )
 
+        if self._image_index is not None:
+            await self._image_index.reload(fingerprint)
+
+    async def update_image(
+        self,
+        fingerprint: str,
+        *,
+        auto_update: bool | None = None,
+        properties: dict[str, str] | None = None,
+    ) -> None:
+        """Update an image's flags and properties.
+
+        Uses HTTP PATCH, so properties are merged into the existing set.
+
+        Args:
+            fingerprint: Full SHA-256 fingerprint of the image.
+            auto_update: New auto-update flag, or None to leave it.
+            properties: Properties to add or overwrite.
+        """
+        body = ImagePut(
+            auto_update=auto_update,
+            properties=properties,
+            expires_at=None,
+            profiles=None,
+            public=None,
+        )
+        await self._request(
+            "PATCH",
+            f"/1.0/images/{fingerprint}",
+            response_type=EmptyResponse,
+            json=body.model_dump(exclude_none=True),
+        )
+
+        if self._image_index is not None:
+            await self._image_index.reload(fingerprint)
+
     async def delete_image(self, fingerprint: str) -> None:
         """Delete an image by fingerprint.
 
@@ -999,6 +1180,9 @@ class IncusClient:
         if operation.id:
             await self.wait_operation(operation.id)
 
+        if self._image_index is not None:
+            self._image_index.discard(fingerprint)
+
     async def get_image_fingerprint_by_alias(self, alias: str) -> str | None:
         """Look up an image fingerprint by alias name.
 
@@ -1008,6 +1192,10 @@ class IncusClient:
         Returns:
             The fingerprint string if the alias exists, or ``None`` if not found.
         """
+        if self._image_index is not None:
+            image = await self._image_index.find_by_alias(alias)
+            return image.fingerprint if image else None
+
         try:
             entry = await self._request(
                 "GET",
@@ -1061,12 +1249,19 @@ class IncusClient:
         """
         # Check if the image is already cached locally by matching
         # alias + server in the local image store.
-        if source.alias:
+        if source.alias and source.server and self._image_index is not None:
+            cached = await self._image_index.find_by_source(
+                source.server, source.alias
+            )
+            if cached is not None:
+                return cached, None
+        elif source.alias:
             for img in await self.list_images():
+                upstream = image_update_source(img)
                 if (
-                    img.update_source
-                    and img.update_source.alias == source.alias
-                    and img.update_source.server == source.server
+                    upstream
+                    and upstream.alias == source.alias
+                    and upstream.server == source.server
                     and img.fingerprint
                 ):
                     return img, None
@@ -12,21 +12,36 @@ Each operation is exposed as a separate D-Bus object at
 - Subscribe to signals for only the operations they care about
 - Avoid race conditions by getting the object path before work starts
 - Cancel operations via a method call
+
+Operation signals are unicast to the client that started the operation
+(and to any that called ``Subscribe()``) instead of being broadcast on
+the system bus.  Only clients running as the requester's user, or as
+root, may subscribe.
+
+Operation ids and resumable operations are recorded in a small journal,
+so ids keep counting across daemon restarts and an interrupted resumable
+operation is started again under its old object path.
 """
 
 from __future__ import annotations
 
 import asyncio
+import contextvars
 import functools
 import itertools
+import json
 import logging
+import os
+import time
 from collections.abc import AsyncGenerator, Awaitable, Callable
 from contextlib import AbstractAsyncContextManager, asynccontextmanager
 from dataclasses import dataclass, field
 from enum import IntEnum
+from pathlib import Path
 from typing import (
     Annotated,
     Any,
+    ClassVar,
     Concatenate,
     ParamSpec,
     Protocol,
@@ -34,9 +49,12 @@ from typing import (
     runtime_checkable,
 )
 
+from dbus_fast import Message
 from dbus_fast.aio import MessageBus
 from dbus_fast.annotations import DBusBool, DBusSignature, DBusStr
-from dbus_fast.constants import PropertyAccess
+from dbus_fast.constants import ErrorType, PropertyAccess
+from dbus_fast.constants import MessageType as BusMessageType
+from dbus_fast.errors import DBusError
 from dbus_fast.service import ServiceInterface, dbus_method, dbus_property, dbus_signal
 
 logger = logging.getLogger(__name__)
@@ -47,6 +65,32 @@ R = TypeVar("R")
 # Global counter for operation IDs (simpler than UUIDs, easier to debug)
 _operation_counter = itertools.count(1)
 
+# Minimum seconds between progress signals for one bar (10 per second)
+DEFAULT_PROGRESS_INTERVAL = 0.1
+
+# systemd sets STATE_DIRECTORY from StateDirectory= in the unit.
+_STATE_DIR = Path(os.environ.get("STATE_DIRECTORY", "/var/lib/kapsule"))
+JOURNAL_PATH = _STATE_DIR / "operations.json"
+
+# Operation ids are reserved in blocks, so the journal is only written
+# once per this many operations unless one of them is resumable.
+_ID_BLOCK = 100
+
+# Names of the methods decorated with @operation(..., resumable=True)
+_resumable_methods: set[str] = set()
+
+# Unique bus name of the client whose method call is being dispatched.
+# Set by the daemon's message handler before method dispatch.
+current_sender: contextvars.ContextVar[str | None] = contextvars.ContextVar(
+    "current_sender", default=None
+)
+
+# Journal entry of the operation being resumed, while resume_operations()
+# calls its method.
+_resumed_operation: contextvars.ContextVar[JournalEntry | None] = (
+    contextvars.ContextVar("resumed_operation", default=None)
+)
+
 
 class MessageType(IntEnum):
     """Message types for operation progress."""
@@ -84,10 +128,36 @@ class OperationInterface(ServiceInterface):
     - Query operation status
 
     The interface is: org.kde.kapsule.Operation
+
+    Signals are sent with emit(), which addresses them to the requester
+    and subscribers; the @dbus_signal declarations below describe them
+    for introspection.
     """
 
-    def __init__(self, op_id: str, op_type: str, description: str, target: str):
+    # Signatures of the signals sent through emit()
+    _SIGNATURES: ClassVar[dict[str, str]] = {
+        "Message": "isi",
+        "ProgressStarted": "ssii",
+        "ProgressUpdate": "sid",
+        "ProgressTextUpdate": "ss",
+        "ProgressCompleted": "sbs",
+        "Completed": "bs",
+    }
+
+    def __init__(
+        self,
+        op_id: str,
+        op_type: str,
+        description: str,
+        target: str,
+        progress_interval: float = DEFAULT_PROGRESS_INTERVAL,
+        requester: str | None = None,
+    ):
         super().__init__("org.kde.kapsule.Operation")
+        self.progress_interval = progress_interval
+        self._requester = requester
+        self._subscribers: set[str] = set()
+        self._bus: MessageBus | None = None
         self._op_id = op_id
         self._op_type = op_type
         self._description = description
@@ -96,6 +166,8 @@ class OperationInterface(ServiceInterface):
         self._error_message = ""
         self._cancel_requested = False
         self._task: asyncio.Task[None] | None = None
+        # Progress bars started but not completed, by id
+        self._progress_bars: dict[str, ProgressBar] = {}
 
     @property
     def object_path(self) -> str:
@@ -106,6 +178,10 @@ class OperationInterface(ServiceInterface):
         """Set the asyncio task for this operation (for cancellation)."""
         self._task = task
 
+    def set_bus(self, bus: MessageBus) -> None:
+        """Set the bus that signals are sent on once exported."""
+        self._bus = bus
+
     # -------------------------------------------------------------------------
     # Properties
     # -------------------------------------------------------------------------
@@ -242,6 +318,42 @@ class OperationInterface(ServiceInterface):
     # Methods
     # -------------------------------------------------------------------------
 
+    @dbus_method()
+    async def Subscribe(self) -> DBusBool:
+        """Receive this operation's signals as well as its requester.
+
+        Signals are only sent to the client that started the operation.
+        Other observers, such as a job tracker, call this to receive them
+        until the operation finishes.  They must run as the same user as
+        the requester, or as root, since progress messages can name the
+        requester's files and containers.
+
+        Returns True if subscribed, False if the operation already
+        finished.  Fails with AccessDenied for other users.
+        """
+        if self._status != "running":
+            return False
+
+        sender = current_sender.get()
+        if not sender or self._requester is None or sender == self._requester:
+            # Daemon-initiated operations are broadcast anyway.
+            return True
+
+        sender_uid = await self._connection_uid(sender)
+        if sender_uid != 0:
+            requester_uid = await self._connection_uid(self._requester)
+            if sender_uid is None or sender_uid != requester_uid:
+                raise DBusError(
+                    ErrorType.ACCESS_DENIED,
+                    "Only the requesting user can subscribe to this operation",
+                )
+
+        # The lookups yield, so the operation may have finished meanwhile.
+        if self._status != "running":
+            return False
+        self._subscribers.add(sender)
+        return True
+
     @dbus_method()
     def Cancel(self) -> DBusBool:
         """Request cancellation of this operation.
@@ -249,6 +361,17 @@ class OperationInterface(ServiceInterface):
         Returns True if cancellation was requested, False if already
         completed or cancellation not supported.
         """
+        return self.request_cancel()
+
+    # -------------------------------------------------------------------------
+    # Internal helpers (not exposed over D-Bus)
+    # -------------------------------------------------------------------------
+
+    def request_cancel(self) -> bool:
+        """Cancel the operation's task, as the Cancel() method does.
+
+        Returns False if the operation already finished.
+        """
         if self._status != "running":
             return False
 
@@ -260,16 +383,86 @@ class OperationInterface(ServiceInterface):
 
         return True
 
-    # -------------------------------------------------------------------------
-    # Internal helpers (not exposed over D-Bus)
-    # -------------------------------------------------------------------------
-
     def is_cancel_requested(self) -> bool:
         """Check if cancellation has been requested."""
         return self._cancel_requested
 
+    def is_running(self) -> bool:
+        """Check whether Completed has not been emitted yet."""
+        return self._status == "running"
+
+    def status(self) -> str:
+        """Current status, as in the Status property."""
+        return self._status
+
+    def add_progress_bar(self, bar: ProgressBar) -> None:
+        """Track a live bar, so its last updates are sent on completion."""
+        self._progress_bars[bar.progress_id] = bar
+
+    def remove_progress_bar(self, bar: ProgressBar) -> None:
+        """Stop tracking a bar that completed."""
+        self._progress_bars.pop(bar.progress_id, None)
+
+    async def _connection_uid(self, name: str) -> int | None:
+        """Return the uid of a bus connection, or None if it is gone."""
+        if self._bus is None:
+            return None
+        reply = await self._bus.call(
+            Message(
+                destination="org.freedesktop.DBus",
+                path="/org/freedesktop/DBus",
+                interface="org.freedesktop.DBus",
+                member="GetConnectionUnixUser",
+                signature="s",
+                body=[name],
+            )
+        )
+        if reply is None or reply.message_type == BusMessageType.ERROR:
+            return None
+        uid: int = reply.body[0]
+        return uid
+
+    def emit(self, member: str, *body: Any) -> None:
+        """Send one of this interface's signals to its observers.
+
+        The signal is addressed to the requester and each subscriber.
+        Operations the daemon started on its own have no requester, so
+        their signals are broadcast.
+
+        Args:
+            member: Signal name (e.g. "ProgressUpdate")
+            *body: Signal arguments, matching the declaration above
+        """
+        if self._bus is None:
+            return
+
+        destinations: list[str | None] = [None]
+        if self._requester is not None:
+            destinations = [self._requester, *self._subscribers]
+
+        for destination in destinations:
+            self._bus.send(
+                Message(
+                    message_type=BusMessageType.SIGNAL,
+                    destination=destination,
+                    path=self.object_path,
+                    interface=self.name,
+                    member=member,
+                    signature=self._SIGNATURES[member],
+                    body=list(body),
+                )
+            )
+
     def mark_completed(self, success: bool, message: str = "") -> None:
-        """Mark the operation as completed and emit the Completed signal."""
+        """Mark the operation as completed and emit the Completed signal.
+
+        Bars that were never completed (e.g. when the operation was
+        cancelled) first send their coalesced final position and text.
+        """
+        for bar in list(self._progress_bars.values()):
+            bar.flush()
+        self._progress_bars.clear()
+
         self._status = "completed" if success else "failed"
         if self._cancel_requested and not success:
             self._status = "cancelled"
@@ -286,7 +479,7 @@ class OperationInterface(ServiceInterface):
         else:
             logger.error("Operation %s failed: %s", self._op_id, message)
 
-        self.Completed(success, message)
+        self.emit("Completed", success, message)
 
 
 # =============================================================================
@@ -296,10 +489,23 @@ class OperationInterface(ServiceInterface):
 
 @dataclass
 class ProgressBar:
-    """Handle for an active progress bar."""
+    """Handle for an active progress bar.
+
+    Every update is sent as a signal to each of the operation's observers,
+    so updates are coalesced: at most one ProgressUpdate/ProgressTextUpdate
+    pair is emitted per ``_interval`` seconds, carrying the latest values.
+    Whatever is pending when the bar or its operation completes is
+    flushed before ProgressCompleted or Completed.
+    """
 
     progress_id: str
     _operation: OperationInterface
+    _interval: float = DEFAULT_PROGRESS_INTERVAL
+    _last_emit: float = float("-inf")
+    _pending_update: tuple[int, float] | None = None
+    _pending_text: str | None = None
+    _flush_handle: asyncio.TimerHandle | None = None
+    _completed: bool = False
 
     def update(self, current: int, rate: float = 0.0) -> None:
         """Update progress bar position.
@@ -308,7 +514,8 @@ class ProgressBar:
             current: Current progress value (bytes, items, etc.)
             rate: Rate of progress (bytes/sec, etc.) for ETA calculation
         """
-        self._operation.ProgressUpdate(self.progress_id, current, rate)
+        self._pending_update = (current, rate)
+        self._schedule_flush()
 
     def update_text(self, text: str) -> None:
         """Update progress bar with raw text (e.g. download progress).
@@ -316,16 +523,70 @@ class ProgressBar:
         Args:
             text: Raw progress text from Incus (e.g. "rootfs: 42% (49.2MB/s)")
         """
-        self._operation.ProgressTextUpdate(self.progress_id, text)
+        self._pending_text = text
+        self._schedule_flush()
 
     def complete(self, success: bool = True, message: str = "") -> None:
         """Complete and remove the progress bar.
 
+        Never rate limited; only the first call has an effect.
+
         Args:
             success: Whether the operation succeeded
             message: Optional message to display (replaces the bar)
         """
-        self._operation.ProgressCompleted(self.progress_id, success, message)
+        if self._completed:
+            return
+        self._flush()
+        self._completed = True
+        self._operation.remove_progress_bar(self)
+        self._operation.emit("ProgressCompleted", self.progress_id, success, message)
+
+    def flush(self) -> None:
+        """Emit any pending update now, regardless of the interval."""
+        self._flush()
+
+    def _schedule_flush(self) -> None:
+        """Emit pending updates now, or arm a timer for when the interval ends."""
+        if self._completed or self._flush_handle is not None:
+            return
+
+        delay = self._last_emit + self._interval - time.monotonic()
+        if delay <= 0:
+            self._flush()
+            return
+
+        try:
+            loop = asyncio.get_running_loop()
+        except RuntimeError:
+            # No loop to defer to: don't hold the update back
+            self._flush()
+            return
+        self._flush_handle = loop.call_later(delay, self._flush)
+
+    def _flush(self) -> None:
+        """Emit the latest pending text and position, if any."""
+        if self._flush_handle is not None:
+            self._flush_handle.cancel()
+            self._flush_handle = None
+
+        if self._completed or not self._operation.is_running():
+            self._pending_text = None
+            self._pending_update = None
+            return
+
+        # Text first: clients redraw the bar on position updates
+        if self._pending_text is not None:
+            self._operation.emit(
+                "ProgressTextUpdate", self.progress_id, self._pending_text
+            )
+            self._pending_text = None
+            self._last_emit = time.monotonic()
+        if self._pending_update is not None:
+            current, rate = self._pending_update
+            self._operation.emit("ProgressUpdate", self.progress_id, current, rate)
+            self._pending_update = None
+            self._last_emit = time.monotonic()
 
 
 class NullProgressBar:
@@ -474,7 +735,8 @@ class DBusOperationReporter:
     def info(self, message: str, indent: int | None = None) -> None:
         """Emit an info message."""
         logger.info("[op %s] %s", self.operation_id, message)
-        self._operation.Message(
+        self._operation.emit(
+            "Message",
             int(MessageType.INFO),
             message,
             indent if indent is not None else self._indent,
@@ -483,7 +745,8 @@ class DBusOperationReporter:
     def success(self, message: str, indent: int | None = None) -> None:
         """Emit a success message."""
         logger.info("[op %s] %s", self.operation_id, message)
-        self._operation.Message(
+        self._operation.emit(
+            "Message",
             int(MessageType.SUCCESS),
             message,
             indent if indent is not None else self._indent,
@@ -492,7 +755,8 @@ class DBusOperationReporter:
     def warning(self, message: str, indent: int | None = None) -> None:
         """Emit a warning message."""
         logger.warning("[op %s] %s", self.operation_id, message)
-        self._operation.Message(
+        self._operation.emit(
+            "Message",
             int(MessageType.WARNING),
             message,
             indent if indent is not None else self._indent,
@@ -501,7 +765,8 @@ class DBusOperationReporter:
     def error(self, message: str, indent: int | None = None) -> None:
         """Emit an error message."""
         logger.error("[op %s] %s", self.operation_id, message)
-        self._operation.Message(
+        self._operation.emit(
+            "Message",
             int(MessageType.ERROR),
             message,
             indent if indent is not None else self._indent,
@@ -510,7 +775,8 @@ class DBusOperationReporter:
     def dim(self, message: str, indent: int | None = None) -> None:
         """Emit a dimmed/secondary message."""
         logger.debug("[op %s] %s", self.operation_id, message)
-        self._operation.Message(
+        self._operation.emit(
+            "Message",
             int(MessageType.DIM),
             message,
             indent if indent is not None else self._indent,
@@ -519,7 +785,8 @@ class DBusOperationReporter:
     def hint(self, message: str, indent: int | None = None) -> None:
         """Emit a hint message."""
         logger.info("[op %s] %s", self.operation_id, message)
-        self._operation.Message(
+        self._operation.emit(
+            "Message",
             int(MessageType.HINT),
             message,
             indent if indent is not None else self._indent,
@@ -547,13 +814,20 @@ class DBusOperationReporter:
             description,
             total if total >= 0 else "indeterminate",
         )
-        self._operation.ProgressStarted(
+        self._operation.emit(
+            "ProgressStarted",
             progress_id,
             description,
             total,
             indent if indent is not None else self._indent,
         )
-        return ProgressBar(progress_id, self._operation)
+        bar = ProgressBar(
+            progress_id,
+            self._operation,
+            _interval=self._operation.progress_interval,
+        )
+        self._operation.add_progress_bar(bar)
+        return bar
 
     @asynccontextmanager
     async def track(
@@ -603,6 +877,90 @@ class DBusOperationReporter:
 # =============================================================================
 
 
+@dataclass
+class JournalEntry:
+    """A resumable operation as recorded in the journal."""
+
+    id: str
+    method: str
+    kwargs: dict[str, Any]
+    requester: str | None = None
+
+
+class OperationJournal:
+    """On-disk record of operation ids and resumable operations.
+
+    Clients wait on operations by object path, so ids must never repeat
+    across daemon restarts: a client that reconnects could otherwise
+    mistake a new operation for the one it was waiting on.  Resumable
+    operations are recorded while they run, so the next daemon can start
+    them again under the same path.
+    """
+
+    def __init__(self, path: Path) -> None:
+        self._path = path
+        self._next_id = 1
+        self._reserved = 0
+        self._entries: dict[str, JournalEntry] = {}
+
+    def load(self) -> list[JournalEntry]:
+        """Read the journal left by the previous daemon.
+
+        Returns:
+            The resumable operations that were still running when it
+            stopped.  They are not kept; resuming one records it again.
+        """
+        try:
+            data = json.loads(self._path.read_text())
+            self._next_id = int(data.get("next_id", 1))
+            entries = [JournalEntry(**e) for e in data.get("operations", [])]
+        except FileNotFoundError:
+            entries = []
+        except (OSError, ValueError, TypeError) as e:
+            logger.warning(
+                "Ignoring unreadable operation journal %s: %s", self._path, e
+            )
+            entries = []
+
+        self._reserved = self._next_id
+        self._entries.clear()
+        return entries
+
+    def next_id(self) -> str:
+        """Allocate an operation id that no earlier daemon has used."""
+        op_id = self._next_id
+        self._next_id += 1
+        if self._next_id > self._reserved:
+            self._reserved = self._next_id + _ID_BLOCK
+            self._save()
+        return str(op_id)
+
+    def record(self, entry: JournalEntry) -> None:
+        """Remember a resumable operation until forget() is called."""
+        self._entries[entry.id] = entry
+        self._save()
+
+    def forget(self, op_id: str) -> None:
+        """Drop a finished operation from the journal."""
+        if self._entries.pop(op_id, None) is not None:
+            self._save()
+
+    def _save(self) -> None:
+        data = {
+            # Stored as the end of the reserved block, so a crash never
+            # hands out an id that was already allocated.
+            "next_id": self._reserved,
+            "operations": [vars(e) for e in self._entries.values()],
+        }
+        tmp = self._path.with_suffix(".tmp")
+        try:
+            self._path.parent.mkdir(parents=True, exist_ok=True)
+            tmp.write_text(json.dumps(data))
+            tmp.replace(self._path)
+        except OSError as e:
+            logger.warning("Failed to write operation journal %s: %s", self._path, e)
+
+
 @dataclass
 class RunningOperation:
     """Tracks a running operation."""
@@ -628,6 +986,36 @@ class OperationTracker:
     )
     _bus: MessageBus | None = None
     _cleanup_delay: float = 5.0  # Seconds to keep completed operations
+    _journal: OperationJournal | None = None
+    progress_interval: float = DEFAULT_PROGRESS_INTERVAL
+
+    def open_journal(self, path: Path) -> list[JournalEntry]:
+        """Persist operation ids and resumable operations in *path*.
+
+        Returns:
+            The resumable operations the previous daemon left running.
+        """
+        self._journal = OperationJournal(path)
+        return self._journal.load()
+
+    def next_id(self) -> str:
+        """Allocate an id for a new operation."""
+        if self._journal is None:
+            return str(next(_operation_counter))
+        return self._journal.next_id()
+
+    def record(self, entry: JournalEntry) -> None:
+        """Journal a resumable operation while it runs."""
+        if self._journal is not None:
+            self._journal.record(entry)
+
+    def set_progress_rate(self, max_rate: float) -> None:
+        """Limit progress signals to *max_rate* per second per bar.
+
+        Args:
+            max_rate: Updates per second; 0 disables rate limiting.
+        """
+        self.progress_interval = 1.0 / max_rate if max_rate > 0 else 0.0
 
     def set_bus(self, bus: MessageBus) -> None:
         """Set the message bus for exporting operation objects."""
@@ -641,6 +1029,7 @@ class OperationTracker:
             logger.debug(
                 "Exporting operation %s to %s", op.id, op.interface.object_path
             )
+            op.interface.set_bus(self._bus)
             self._bus.export(op.interface.object_path, op.interface)
 
     def remove(self, op_id: str) -> None:
@@ -650,6 +1039,8 @@ class OperationTracker:
         to read the final state.
         """
         op = self._operations.pop(op_id, None)
+        if self._journal is not None:
+            self._journal.forget(op_id)
         if op and self._bus:
             # Schedule delayed unexport
             asyncio.create_task(self._delayed_unexport(op.interface))
@@ -685,6 +1076,7 @@ def operation(
     operation_type: str,
     description: str,
     target_param: str = "name",
+    resumable: bool = False,
 ) -> Callable[
     [Callable[Concatenate[Any, OperationReporter, P], Awaitable[None]]],
     Callable[Concatenate[Any, P], Awaitable[str]],
@@ -702,8 +1094,14 @@ def operation(
 
     Args:
         operation_type: Type identifier (e.g., "create", "delete", "start")
-        description: Template string with {param} placeholders for kwargs
+        description: Template string with {param} placeholders for kwargs.
+            List arguments are substituted as a comma-separated string.
         target_param: Name of the parameter that represents the target
+        resumable: Whether the operation may simply be run again if the
+            daemon stops while it is running.  Resumable operations are
+            journaled and restarted by resume_operations() under the same
+            object path.  Their arguments must be keyword-only and JSON
+            serializable.
 
     Example:
         @operation("create", "Creating container: {name}")
@@ -723,19 +1121,42 @@ def operation(
     def decorator(
         func: Callable[Concatenate[Any, OperationReporter, P], Awaitable[None]],
     ) -> Callable[Concatenate[Any, P], Awaitable[str]]:
+        if resumable:
+            _resumable_methods.add(func.__name__)
+
         @functools.wraps(func)
         async def wrapper(self: Any, *args: P.args, **kwargs: P.kwargs) -> str:
-            # Generate operation ID using incrementing counter
-            op_id = str(next(_operation_counter))
+            # A resumed operation keeps its id and requester, so the client
+            # that was waiting on it keeps receiving its signals.
+            resumed = _resumed_operation.get()
+            requester = current_sender.get()
+            if resumed is not None:
+                op_id = resumed.id
+                requester = resumed.requester
+            elif hasattr(self, "_tracker"):
+                op_id = self._tracker.next_id()
+            else:
+                op_id = str(next(_operation_counter))
 
             # Build description from template
-            desc = description.format(**kwargs)
+            fields = {k: _format_arg(v) for k, v in kwargs.items()}
+            desc = description.format(**fields)
 
             # Get target from kwargs
-            target = str(kwargs.get(target_param, ""))
+            target = fields.get(target_param, "")
 
             # Create the operation D-Bus interface
-            op_interface = OperationInterface(op_id, operation_type, desc, target)
+            progress_interval = DEFAULT_PROGRESS_INTERVAL
+            if hasattr(self, "_tracker"):
+                progress_interval = self._tracker.progress_interval
+            op_interface = OperationInterface(
+                op_id,
+                operation_type,
+                desc,
+                target,
+                progress_interval,
+                requester=requester,
+            )
 
             # Create the reporter that wraps the interface
             reporter = DBusOperationReporter(
@@ -747,6 +1168,11 @@ def operation(
                 logger.info(
                     "Operation %s (%s) starting: %s", op_id, operation_type, desc
                 )
+                if resumed is not None:
+                    # The task inherited the resume context; operations it
+                    # starts itself are new ones.
+                    _resumed_operation.set(None)
+                    reporter.info("Resuming after a daemon restart")
                 try:
                     await func(self, reporter, *args, **kwargs)
                     op_interface.mark_completed(True, "")
@@ -781,6 +1207,11 @@ def operation(
                 )
                 op_interface.set_task(task)
 
+                if resumable:
+                    self._tracker.record(
+                        JournalEntry(op_id, func.__name__, dict(kwargs), requester)
+                    )
+
                 # Export to D-Bus before the task starts running
                 self._tracker.add(
                     RunningOperation(
@@ -805,3 +1236,39 @@ def operation(
         return wrapper
 
     return decorator
+
+
+async def resume_operations(service: Any, entries: list[JournalEntry]) -> None:
+    """Start journaled operations again under their old object paths.
+
+    Operations that aren't resumable (or whose method no longer exists)
+    are dropped: they died with the previous daemon, and clients waiting
+    on them find their object gone and fail the wait.
+
+    Args:
+        service: The object whose @operation methods are resumed
+        entries: Journal entries returned by OperationTracker.open_journal()
+    """
+    for entry in entries:
+        method = getattr(service, entry.method, None)
+        if entry.method not in _resumable_methods or method is None:
+            logger.warning(
+                "Dropping interrupted operation %s (%s)", entry.id, entry.method
+            )
+            continue
+
+        logger.info("Resuming operation %s (%s)", entry.id, entry.method)
+        token = _resumed_operation.set(entry)
+        try:
+            await method(**entry.kwargs)
+        except Exception:
+            logger.exception("Failed to resume operation %s", entry.id)
+        finally:
+            _resumed_operation.reset(token)
+
+
+def _format_arg(value: object) -> str:
+    """Format an operation argument for its description and target."""
+    if isinstance(value, (list, tuple)):
+        return ", ".join(str(v) for v in value)
+    return str(value)
@@ -16,10 +16,11 @@ import json
 import logging
 from typing import cast
 
+import httpx
 from websockets.asyncio.client import unix_connect
 from websockets.exceptions import ConnectionClosed
 
-from .incus_client import IncusClient
+from .incus_client import IncusClient, IncusError
 from .models_generated import Operation
 from .operations import OperationReporter
 
@@ -158,10 +159,22 @@ async def wait_operation_with_progress(
 
         return final_op
 
+    except asyncio.CancelledError:
+        # The D-Bus operation was cancelled; don't leave Incus downloading
+        # gigabytes nobody will use.  Shield the request so it is sent even
+        # though this task is being torn down.
+        bar.complete(success=False, message="Cancelled")
+        with contextlib.suppress(IncusError, httpx.HTTPError):
+            await asyncio.shield(incus.cancel_operation(operation_id))
+        raise
     except Exception:
         bar.complete(success=False)
         raise
     finally:
+        if not wait_task.done():
+            wait_task.cancel()
+            with contextlib.suppress(asyncio.CancelledError):
+                await wait_task
         monitor_task.cancel()
         with contextlib.suppress(asyncio.CancelledError):
             await monitor_task
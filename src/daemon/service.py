@@ -9,7 +9,6 @@ Provides the org.kde.kapsule.Manager interface for container management.
 
 from __future__ import annotations
 
-import contextvars
 import json
 import logging
 from dataclasses import dataclass
@@ -28,31 +27,33 @@ from dbus_fast.constants import PropertyAccess
 from dbus_fast.service import ServiceInterface, dbus_method, dbus_property, dbus_signal
 
 from . import __version__
+from .config import load_refresh_config
 from .container import ContainerService
 from .container_options import (
+    CREATE_SCHEMA,
     get_create_schema_json,
 )
 from .dbus_types import (
     DBusContainer,
     DBusContainerList,
+    DBusContainerListV2,
+    DBusContainerStats,
     DBusEnterResult,
+    DBusImageList,
     DBusStrArray,
     DBusStrDict,
     DBusVariantDict,
 )
 from .host_config_sync import HostConfigSync
+from .image_index import ImageIndex
+from .image_refresh import ImageRefreshScheduler
 
 # Re-export IncusClient for use in __main__ and CLI
 from .incus_client import IncusClient, IncusError
+from .operations import current_sender as _current_sender
 
 logger = logging.getLogger(__name__)
 
-# Context variable to store the current D-Bus message sender
-# This is set by a message handler before method dispatch
-_current_sender: contextvars.ContextVar[str | None] = contextvars.ContextVar(
-    "current_sender", default=None
-)
-
 
 @dataclass(frozen=True)
 class CallerCredentials:
@@ -200,6 +201,15 @@ class KapsuleManagerInterface(ServiceInterface):
         """Daemon version."""
         return self._version
 
+    @dbus_property(access=PropertyAccess.READ)
+    def CreateSchemaVersion(self) -> DBusUInt32:
+        """Version of the schema returned by GetCreateSchema.
+
+        Clients that cache the schema read this together with Version
+        to tell whether their copy is still current.
+        """
+        return CREATE_SCHEMA["version"]
+
     # =========================================================================
     # Signals
     # =========================================================================
@@ -209,21 +219,55 @@ class KapsuleManagerInterface(ServiceInterface):
         """Emitted when the container list changes.
 
         Fired after a container is created, deleted, started, or stopped.
-        Clients should re-fetch the container list when this signal is received.
+        Kept for older clients; it always follows a ``ContainerUpdated`` or
+        ``ContainerRemoved`` signal carrying the actual change, so new
+        clients should apply those instead of re-fetching the list.
         """
 
+    @dbus_signal()
+    def ContainerUpdated(
+        self,
+        name: DBusStr,
+        state: DBusStr,
+        image: DBusStr,
+        created: DBusStr,
+        mode: DBusStr,
+    ) -> Annotated[tuple[str, str, str, str, str], DBusSignature("sssss")]:
+        """Emitted when a container is created or its state changes.
+
+        Args:
+            name: Container name
+            state: Container status (e.g. "Running", "Stopped")
+            image: Image description
+            created: Creation time (ISO 8601)
+            mode: Kapsule D-Bus mode ("Default", "Session" or "DbusMux")
+        """
+        return (name, state, image, created, mode)
+
+    @dbus_signal()
+    def ContainerRemoved(self, name: DBusStr) -> DBusStr:
+        """Emitted when a container is deleted.
+
+        Args:
+            name: Container name
+        """
+        return name
+
     # =========================================================================
     # Methods - Operations Query
     # =========================================================================
 
     @dbus_method()
-    def ListOperations(self) -> Annotated[list[str], DBusSignature("ao")]:
+    async def ListOperations(self) -> Annotated[list[str], DBusSignature("ao")]:
         """List all currently running operations.
 
+        Right after startup this waits until the operations interrupted by
+        the previous daemon have been resumed, so they are included.
+
         Returns:
             Array of D-Bus object paths for running operations
         """
-        return self._service.list_operations()
+        return await self._service.list_running_operations()
 
     # =========================================================================
     # Methods - Container Lifecycle
@@ -330,6 +374,51 @@ class KapsuleManagerInterface(ServiceInterface):
         """
         return await self._service.stop_container(name=name, force=force)
 
+    @dbus_method()
+    async def DeleteContainers(
+        self, names: DBusStrArray, force: DBusBool
+    ) -> DBusObjectPath:
+        """Delete several containers as one operation.
+
+        Containers are removed in parallel, a few at a time.  One failing
+        does not stop the others.
+
+        Args:
+            names: Container names
+            force: Force removal of running containers
+
+        Returns:
+            D-Bus object path for tracking operation progress
+        """
+        return await self._service.delete_containers(names=names, force=force)
+
+    @dbus_method()
+    async def StartContainers(self, names: DBusStrArray) -> DBusObjectPath:
+        """Start several containers as one operation.
+
+        Args:
+            names: Container names
+
+        Returns:
+            D-Bus object path for tracking operation progress
+        """
+        return await self._service.start_containers(names=names)
+
+    @dbus_method()
+    async def StopContainers(
+        self, names: DBusStrArray, force: DBusBool
+    ) -> DBusObjectPath:
+        """Stop several containers as one operation.
+
+        Args:
+            names: Container names
+            force: Force stop
+
+        Returns:
+            D-Bus object path for tracking operation progress
+        """
+        return await self._service.stop_containers(names=names, force=force)
+
     @dbus_method()
     async def RefreshImages(self, image: DBusStr) -> DBusObjectPath:
         """Refresh cached images from their upstream sources.
@@ -375,6 +464,19 @@ class KapsuleManagerInterface(ServiceInterface):
         images = await self._service.list_images()
         return json.dumps([img.model_dump(mode="json") for img in images])
 
+    @dbus_method()
+    async def ListImagesV2(self) -> DBusImageList:
+        """List all images known to the local Incus daemon.
+
+        Unlike ListImages, only the fields clients display are sent,
+        as typed structs instead of a JSON dump of every image.
+
+        Returns:
+            Array of (fingerprint, aliases, description, size, uploaded)
+            tuples
+        """
+        return await self._service.list_image_summaries()
+
     @dbus_method()
     async def DeleteImage(self, identifier: DBusStr) -> DBusObjectPath:
         """Delete an image by alias or fingerprint.
@@ -452,6 +554,82 @@ class KapsuleManagerInterface(ServiceInterface):
         """
         return await self._service.list_containers()
 
+    @dbus_method()
+    async def ListContainersV2(self) -> DBusContainerListV2:
+        """List all containers in the compact v2 format.
+
+        Carries state and mode as integers and the creation time as a Unix
+        timestamp, so clients don't parse strings for every row, plus an
+        a{sv} of optional extra fields.  Available from daemon version
+        0.3.0; clients check the Version property before calling it.
+
+        Returns:
+            Array of (name, state, image, created, mode, extra) tuples
+        """
+        return await self._service.list_containers_v2()
+
+    @dbus_method()
+    async def QueryContainers(
+        self, filter: DBusVariantDict, fields: DBusStrArray
+    ) -> DBusContainerList:
+        """List the containers matching a filter.
+
+        Cheaper than ListContainers for callers that only need some
+        containers or some fields: containers in unwanted states are never
+        read, and a names-only query skips loading the containers at all.
+
+        Args:
+            filter: Any of "states" (as, Incus status names such as
+                "Running"), "name" (s, shell-style glob) and "image"
+                (s, image description).  Missing keys match everything.
+            fields: Fields to fill in besides the name, out of "status",
+                "image", "created" and "mode"; empty for all.  The others
+                are returned as empty strings.
+
+        Returns:
+            Array of (name, status, image, created, mode) tuples
+        """
+        criteria: dict[str, object] = {}
+        for key, value in filter.items():
+            while isinstance(value, Variant):
+                value = value.value
+            criteria[key] = value
+
+        states = criteria.get("states", [])
+        name = criteria.get("name", "")
+        image = criteria.get("image", "")
+        if not (
+            isinstance(states, list)
+            and isinstance(name, str)
+            and isinstance(image, str)
+        ):
+            raise Exception("Invalid container filter")
+
+        return await self._service.query_containers(
+            states=[str(state) for state in states],
+            name=name,
+            image=image,
+            fields=list(fields),
+        )
+
+    @dbus_method()
+    async def GetContainerStats(self, names: DBusStrArray) -> DBusContainerStats:
+        """Sample resource usage of running containers.
+
+        The states of all containers are read in one batch, so callers
+        polling for a live view should ask for everything at once.
+
+        Args:
+            names: Containers to report, or empty for all running ones.
+                Stopped containers are left out.
+
+        Returns:
+            Array of (name, cpu_time, memory_usage, memory_limit,
+            swap_usage, disk_usage, bytes_received, bytes_sent,
+            processes) tuples. CPU time is cumulative nanoseconds.
+        """
+        return await self._service.container_stats(list(names))
+
     @dbus_method()
     async def GetContainerInfo(self, name: DBusStr) -> DBusContainer:
         """Get information about a container.
@@ -563,8 +741,10 @@ class KapsuleService:
         self._bus: MessageBus | None = None
         self._interface: KapsuleManagerInterface | None = None
         self._incus: IncusClient | None = None
+        self._image_index: ImageIndex | None = None
         self._container_service: ContainerService | None = None
         self._host_config_sync: HostConfigSync | None = None
+        self._image_refresh: ImageRefreshScheduler | None = None
 
     async def start(self) -> None:
         """Start the D-Bus service."""
@@ -577,6 +757,11 @@ class KapsuleService:
         # Ensure Incus is initialized with the storage pool we need
         await self._ensure_storage_pool()
 
+        # Serve image lookups from memory, following Incus lifecycle events
+        self._image_index = ImageIndex(self._incus)
+        self._incus.set_image_index(self._image_index)
+        self._image_index.start()
+
         # Create the interface and container service
         # The interface needs the service, and the service needs the interface
         # So we use deferred initialization
@@ -595,6 +780,12 @@ class KapsuleService:
 
         await self._host_config_sync.start()
 
+        # Keep auto-update images fresh in the background
+        self._image_refresh = ImageRefreshScheduler(
+            self._bus, self._container_service, load_refresh_config()
+        )
+        image_refresh = self._image_refresh
+
         # Export the interface
         self._bus.export("/org/kde/kapsule", self._interface)
 
@@ -603,6 +794,9 @@ class KapsuleService:
             """Capture the sender of incoming method calls."""
             if msg.message_type == MessageType.METHOD_CALL:
                 _current_sender.set(msg.sender)
+                # Only calls meant for us reach this connection, whether
+                # addressed to org.kde.kapsule or to our unique name.
+                image_refresh.note_activity(msg.member)
             return None  # Let normal processing continue
 
         self._bus.add_message_handler(capture_sender)
@@ -610,6 +804,13 @@ class KapsuleService:
         # Request the well-known name
         await self._bus.request_name("org.kde.kapsule")
 
+        # Pick up operations the previous daemon was running when it
+        # stopped.  Only now, so that their signals come from the name
+        # clients follow; ListOperations waits for this to finish.
+        await self._container_service.resume_operations()
+
+        self._image_refresh.start()
+
         bus_name = "system" if self._bus_type == BusType.SYSTEM else "session"
         print(f"Kapsule daemon v{__version__} running on {bus_name} bus")
         print("Service: org.kde.kapsule")
@@ -623,8 +824,16 @@ class KapsuleService:
 
     async def stop(self) -> None:
         """Stop the D-Bus service."""
+        if self._image_refresh:
+            await self._image_refresh.stop()
+            self._image_refresh = None
+
         self._host_config_sync = None
 
+        if self._image_index:
+            await self._image_index.stop()
+            self._image_index = None
+
         if self._incus:
             await self._incus.close()
             self._incus = None
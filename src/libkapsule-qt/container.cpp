@@ -4,6 +4,7 @@
 */
 
 #include "container.h"
+#include "kapsuledbustypes.h"
 
 #include <QDBusArgument>
 #include <QSharedData>
@@ -35,6 +36,9 @@ public:
     QString image;
     ContainerMode mode = ContainerMode::Default;
     QDateTime created;
+    QDateTime startedAt;
+    qint64 pid = 0;
+    QList<uint> setUpUsers;
 };
 
 // ============================================================================
@@ -88,11 +92,42 @@ QDateTime Container::created() const
     return d->created;
 }
 
+QDateTime Container::startedAt() const
+{
+    return d->startedAt;
+}
+
+qint64 Container::pid() const
+{
+    return d->pid;
+}
+
+QList<uint> Container::setUpUsers() const
+{
+    return d->setUpUsers;
+}
+
 bool Container::isRunning() const
 {
     return d->state == State::Running;
 }
 
+Container Container::fromWire(const QString &name, const QString &status,
+                              const QString &image, const QString &created,
+                              const QString &mode)
+{
+    Container container(name);
+    container.d->image = image;
+    container.d->mode = containerModeFromString(mode);
+    container.d->created = QDateTime::fromString(created, Qt::ISODate);
+
+    bool ok = false;
+    int value = QMetaEnum::fromType<Container::State>().keyToValue(status.toLatin1().constData(), &ok);
+    container.d->state = ok ? static_cast<Container::State>(value) : Container::State::Unknown;
+
+    return container;
+}
+
 bool Container::operator==(const Container &other) const
 {
     return d->name == other.d->name;
@@ -126,15 +161,69 @@ const QDBusArgument &operator>>(const QDBusArgument &arg, Container &container)
     arg >> name >> status >> image >> created >> mode;
     arg.endStructure();
 
-    container.d->name = name;
-    container.d->image = image;
-    container.d->mode = containerModeFromString(mode);
-    container.d->created = QDateTime::fromString(created, Qt::ISODate);
+    container = Container::fromWire(name, status, image, created, mode);
+    return arg;
+}
 
-    bool ok = false;
-    int value = QMetaEnum::fromType<Container::State>().keyToValue(status.toLatin1().constData(), &ok);
-    container.d->state = ok ? static_cast<Container::State>(value) : Container::State::Unknown;
+// The v2 format carries enum values and a timestamp, so decoding a row
+// involves no string-to-enum lookups or date parsing.
+
+QDBusArgument &operator<<(QDBusArgument &arg, const ContainerV2 &wire)
+{
+    const ContainerData &data = *wire.container.d;
+
+    QVariantMap extra;
+    if (data.startedAt.isValid()) {
+        extra.insert(QStringLiteral("started_at"), data.startedAt.toSecsSinceEpoch());
+    }
+    if (data.pid) {
+        extra.insert(QStringLiteral("pid"), data.pid);
+    }
+    if (!data.setUpUsers.isEmpty()) {
+        extra.insert(QStringLiteral("setup_users"), QVariant::fromValue(data.setUpUsers));
+    }
+
+    arg.beginStructure();
+    arg << data.name
+        << static_cast<int>(data.state)
+        << data.image
+        << (data.created.isValid() ? data.created.toSecsSinceEpoch() : qint64(0))
+        << static_cast<int>(data.mode)
+        << extra;
+    arg.endStructure();
+    return arg;
+}
+
+const QDBusArgument &operator>>(const QDBusArgument &arg, ContainerV2 &wire)
+{
+    QString name, image;
+    int state = 0, mode = 0;
+    qint64 created = 0;
+    QVariantMap extra;
+    arg.beginStructure();
+    arg >> name >> state >> image >> created >> mode >> extra;
+    arg.endStructure();
+
+    // Values from a newer daemon that this library doesn't know about
+    // fall back to the defaults, like unknown strings in the v1 format.
+    if (state < 0 || state > static_cast<int>(Container::State::Error)) {
+        state = static_cast<int>(Container::State::Unknown);
+    }
+    if (mode < 0 || mode > static_cast<int>(ContainerMode::DbusMux)) {
+        mode = static_cast<int>(ContainerMode::Default);
+    }
 
+    auto *data = new ContainerData(name, static_cast<Container::State>(state), image,
+                                   static_cast<ContainerMode>(mode),
+                                   created ? QDateTime::fromSecsSinceEpoch(created) : QDateTime());
+    if (const qint64 startedAt = extra.value(QStringLiteral("started_at")).toLongLong()) {
+        data->startedAt = QDateTime::fromSecsSinceEpoch(startedAt);
+    }
+    data->pid = extra.value(QStringLiteral("pid")).toLongLong();
+    if (const auto users = extra.constFind(QStringLiteral("setup_users")); users != extra.constEnd()) {
+        data->setUpUsers = qdbus_cast<QList<uint>>(*users);
+    }
+    wire.container.d = data;
     return arg;
 }
 
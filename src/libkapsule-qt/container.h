@@ -20,6 +20,7 @@ class QDBusArgument;
 namespace Kapsule {
 
 class ContainerData;
+struct ContainerV2;
 
 /**
  * @class Container
@@ -39,6 +40,8 @@ class KAPSULE_EXPORT Container
     Q_PROPERTY(QString image READ image)
     Q_PROPERTY(ContainerMode mode READ mode)
     Q_PROPERTY(QDateTime created READ created)
+    Q_PROPERTY(QDateTime startedAt READ startedAt)
+    Q_PROPERTY(qint64 pid READ pid)
 
 public:
     /**
@@ -127,6 +130,38 @@ public:
      */
     [[nodiscard]] QDateTime created() const;
 
+    /**
+     * @brief Returns when the running container was last started.
+     *
+     * Only reported by daemons that support the compact v2 container
+     * format (0.3.0 and later), and only in container lists.
+     *
+     * @return The start timestamp, or an invalid QDateTime if the
+     *         container is not running or the time is unknown.
+     */
+    [[nodiscard]] QDateTime startedAt() const;
+
+    /**
+     * @brief Returns the host PID of the running container's init process.
+     *
+     * Only reported by daemons that support the compact v2 container
+     * format (0.3.0 and later), and only in container lists.
+     *
+     * @return The PID, or 0 if the container is not running or the PID
+     *         is unknown.
+     */
+    [[nodiscard]] qint64 pid() const;
+
+    /**
+     * @brief Returns the host users that have been set up in the container.
+     *
+     * Only reported by daemons that support the compact v2 container
+     * format (0.3.0 and later), and only in container lists.
+     *
+     * @return The UIDs of the users, in ascending order.
+     */
+    [[nodiscard]] QList<uint> setUpUsers() const;
+
     /**
      * @brief Returns whether the container is running.
      * @return true if running, false otherwise.
@@ -144,12 +179,40 @@ public:
     bool operator!=(const Container &other) const;
 
 private:
+    /**
+     * Builds a container from its D-Bus wire fields (name, status, image,
+     * created, mode), as sent by ListContainers and ContainerUpdated.
+     */
+    static Container fromWire(const QString &name, const QString &status,
+                              const QString &image, const QString &created,
+                              const QString &mode);
+
     QSharedDataPointer<ContainerData> d;
 
     friend class KapsuleClient;
     friend class KapsuleClientPrivate;
     friend KAPSULE_EXPORT QDBusArgument &operator<<(QDBusArgument &arg, const Container &container);
     friend KAPSULE_EXPORT const QDBusArgument &operator>>(const QDBusArgument &arg, Container &container);
+    friend QDBusArgument &operator<<(QDBusArgument &arg, const ContainerV2 &container);
+    friend const QDBusArgument &operator>>(const QDBusArgument &arg, ContainerV2 &container);
+};
+
+/**
+ * @brief Server-side selection for KapsuleClient::listContainers().
+ *
+ * Every criterion left empty matches all containers.  The daemon never
+ * loads containers in states that were not asked for, and a query for
+ * names only does not load any container at all.
+ */
+struct KAPSULE_EXPORT ContainerFilter {
+    QList<Container::State> states;  ///< Only containers in one of these states
+    QString name;                    ///< Shell-style glob the name must match
+    QString image;                   ///< Image description the container must have
+
+    /// Fields to fill in besides the name, out of "status", "image",
+    /// "created" and "mode"; empty for all.  The others are left at their
+    /// defaults (e.g. State::Unknown for an unrequested status).
+    QStringList fields;
 };
 
 // D-Bus argument streaming operators for Container (sssss)
@@ -0,0 +1,236 @@
+/*
+    SPDX-FileCopyrightText: 2024-2026 KDE Community
+    SPDX-License-Identifier: LGPL-2.1-or-later
+*/
+
+#include "containermodel.h"
+#include "kapsuleclient.h"
+
+#include <QHash>
+#include <QSet>
+#include <QTimer>
+
+namespace Kapsule {
+
+// ============================================================================
+// Private implementation
+// ============================================================================
+
+class ContainerModelPrivate
+{
+public:
+    explicit ContainerModelPrivate(ContainerModel *q, KapsuleClient *client);
+
+    void scheduleSync();
+    void apply(const QList<Container> &fresh);
+
+    ContainerModel *q_ptr;
+    KapsuleClient *client;
+    QList<Container> containers;
+    QTimer coalesceTimer;
+};
+
+ContainerModelPrivate::ContainerModelPrivate(ContainerModel *q, KapsuleClient *client)
+    : q_ptr(q)
+    , client(client)
+{
+    // Fire at most once per interval after the first change of a burst.
+    // The timer is not restarted on further changes, so a steady stream
+    // of notifications can't postpone the update indefinitely.
+    coalesceTimer.setSingleShot(true);
+    coalesceTimer.setInterval(100);
+    QObject::connect(&coalesceTimer, &QTimer::timeout, q, [this] {
+        apply(this->client->cachedContainers());
+    });
+}
+
+void ContainerModelPrivate::scheduleSync()
+{
+    if (!coalesceTimer.isActive()) {
+        coalesceTimer.start();
+    }
+}
+
+static QList<int> changedRoles(const Container &before, const Container &after)
+{
+    QList<int> roles;
+    if (before.state() != after.state()) {
+        roles << ContainerModel::StateRole;
+    }
+    if (before.image() != after.image()) {
+        roles << ContainerModel::ImageRole;
+    }
+    if (before.mode() != after.mode()) {
+        roles << ContainerModel::ModeRole;
+    }
+    if (before.created() != after.created()) {
+        roles << ContainerModel::CreatedRole;
+    }
+    if (!roles.isEmpty()) {
+        roles << ContainerModel::ContainerRole;
+    }
+    return roles;
+}
+
+void ContainerModelPrivate::apply(const QList<Container> &fresh)
+{
+    const auto oldCount = containers.size();
+
+    QHash<QString, qsizetype> freshRows;
+    freshRows.reserve(fresh.size());
+    for (qsizetype i = 0; i < fresh.size(); ++i) {
+        freshRows.insert(fresh.at(i).name(), i);
+    }
+
+    // Removals, walking backwards so that contiguous runs of removed
+    // rows go out in a single beginRemoveRows() call.
+    for (qsizetype last = containers.size() - 1; last >= 0; --last) {
+        if (freshRows.contains(containers.at(last).name())) {
+            continue;
+        }
+        qsizetype first = last;
+        while (first > 0 && !freshRows.contains(containers.at(first - 1).name())) {
+            --first;
+        }
+        q_ptr->beginRemoveRows({}, int(first), int(last));
+        containers.remove(first, last - first + 1);
+        q_ptr->endRemoveRows();
+        last = first;
+    }
+
+    // In-place updates, only for the roles that changed.
+    QSet<QString> known;
+    known.reserve(containers.size());
+    for (qsizetype row = 0; row < containers.size(); ++row) {
+        const Container &after = fresh.at(freshRows.value(containers.at(row).name()));
+        known.insert(after.name());
+        const QList<int> roles = changedRoles(containers.at(row), after);
+        if (roles.isEmpty()) {
+            continue;
+        }
+        containers[row] = after;
+        const QModelIndex index = q_ptr->index(int(row));
+        Q_EMIT q_ptr->dataChanged(index, index, roles);
+    }
+
+    // Insertions, appended in the order the daemon reported them.
+    QList<Container> added;
+    for (const Container &container : fresh) {
+        if (!known.contains(container.name())) {
+            added.append(container);
+        }
+    }
+    if (!added.isEmpty()) {
+        const auto first = containers.size();
+        q_ptr->beginInsertRows({}, int(first), int(first + added.size() - 1));
+        containers.append(added);
+        q_ptr->endInsertRows();
+    }
+
+    if (containers.size() != oldCount) {
+        Q_EMIT q_ptr->countChanged();
+    }
+}
+
+// ============================================================================
+// ContainerModel implementation
+// ============================================================================
+
+ContainerModel::ContainerModel(KapsuleClient *client, QObject *parent)
+    : QAbstractListModel(parent)
+    , d(std::make_unique<ContainerModelPrivate>(this, client))
+{
+    connect(client, &KapsuleClient::containersChanged, this, &ContainerModel::refresh);
+    connect(client, &KapsuleClient::containerUpdated, this, &ContainerModel::refresh);
+    connect(client, &KapsuleClient::containerRemoved, this, &ContainerModel::refresh);
+
+    // The cache announces its load with containersChanged()
+    d->apply(client->cachedContainers());
+    QCoro::connect(client->loadContainerCache(), this, [](bool) {});
+}
+
+ContainerModel::~ContainerModel() = default;
+
+int ContainerModel::rowCount(const QModelIndex &parent) const
+{
+    if (parent.isValid()) {
+        return 0;
+    }
+    return int(d->containers.size());
+}
+
+QVariant ContainerModel::data(const QModelIndex &index, int role) const
+{
+    if (!checkIndex(index, CheckIndexOption::IndexIsValid | CheckIndexOption::ParentIsInvalid)) {
+        return {};
+    }
+
+    const Container &container = d->containers.at(index.row());
+    switch (role) {
+    case Qt::DisplayRole:
+    case NameRole:
+        return container.name();
+    case StateRole:
+        return QVariant::fromValue(container.state());
+    case ImageRole:
+        return container.image();
+    case ModeRole:
+        return QVariant::fromValue(container.mode());
+    case CreatedRole:
+        return container.created();
+    case ContainerRole:
+        return QVariant::fromValue(container);
+    }
+    return {};
+}
+
+QHash<int, QByteArray> ContainerModel::roleNames() const
+{
+    return {
+        {NameRole, QByteArrayLiteral("name")},
+        {StateRole, QByteArrayLiteral("state")},
+        {ImageRole, QByteArrayLiteral("image")},
+        {ModeRole, QByteArrayLiteral("mode")},
+        {CreatedRole, QByteArrayLiteral("created")},
+        {ContainerRole, QByteArrayLiteral("container")},
+    };
+}
+
+Container ContainerModel::container(int row) const
+{
+    if (row < 0 || row >= d->containers.size()) {
+        return Container{};
+    }
+    return d->containers.at(row);
+}
+
+int ContainerModel::rowOf(const QString &name) const
+{
+    for (qsizetype row = 0; row < d->containers.size(); ++row) {
+        if (d->containers.at(row).name() == name) {
+            return int(row);
+        }
+    }
+    return -1;
+}
+
+int ContainerModel::coalesceInterval() const
+{
+    return d->coalesceTimer.interval();
+}
+
+void ContainerModel::setCoalesceInterval(int msec)
+{
+    if (d->coalesceTimer.interval() == msec) {
+        return;
+    }
+    d->coalesceTimer.setInterval(msec);
+    Q_EMIT coalesceIntervalChanged();
+}
+
+void ContainerModel::refresh()
+{
+    d->scheduleSync();
+}
+
+} // namespace Kapsule
@@ -0,0 +1,144 @@
+/*
+    SPDX-FileCopyrightText: 2024-2026 KDE Community
+    SPDX-License-Identifier: LGPL-2.1-or-later
+*/
+
+#ifndef KAPSULE_CONTAINERMODEL_H
+#define KAPSULE_CONTAINERMODEL_H
+
+#include <QAbstractListModel>
+#include <memory>
+
+#include "kapsule_export.h"
+#include "container.h"
+
+namespace Kapsule {
+
+class KapsuleClient;
+class ContainerModelPrivate;
+
+/**
+ * @class ContainerModel
+ * @brief List model of the containers managed by kapsule.
+ *
+ * The model mirrors KapsuleClient::cachedContainers(), which the client
+ * keeps in sync with the daemon without re-listing.  Instead of resetting
+ * on every change it compares the cache against its rows and emits row-level
+ * inserts, removes and dataChanged() for only the roles that actually
+ * changed, so views only repaint the affected rows.
+ *
+ * Change notifications that arrive in quick succession (for example
+ * while several containers are started) are coalesced into a single
+ * update.
+ *
+ * Rows keep their position once inserted; new containers are appended.
+ * Use a QSortFilterProxyModel if a particular order is needed.
+ *
+ * @code
+ * KapsuleClient client;
+ * ContainerModel model(&client);
+ * view->setModel(&model);
+ * @endcode
+ *
+ * @since 0.2
+ */
+class KAPSULE_EXPORT ContainerModel : public QAbstractListModel
+{
+    Q_OBJECT
+
+    /**
+     * @property count
+     * @brief Number of containers in the model.
+     */
+    Q_PROPERTY(int count READ rowCount NOTIFY countChanged)
+
+    /**
+     * @property coalesceInterval
+     * @brief How long to wait for further changes before updating rows, in ms.
+     */
+    Q_PROPERTY(int coalesceInterval READ coalesceInterval WRITE setCoalesceInterval NOTIFY coalesceIntervalChanged)
+
+public:
+    /**
+     * @enum Roles
+     * @brief Data roles exposed by the model.
+     */
+    enum Roles {
+        NameRole = Qt::UserRole + 1, ///< QString container name
+        StateRole,                   ///< Container::State
+        ImageRole,                   ///< QString base image
+        ModeRole,                    ///< ContainerMode
+        CreatedRole,                 ///< QDateTime creation time
+        ContainerRole,               ///< The whole Container value
+    };
+    Q_ENUM(Roles)
+
+    /**
+     * @brief Creates a model backed by @p client.
+     * @param client The client whose container cache to mirror. Must outlive the model.
+     * @param parent The parent QObject.
+     */
+    explicit ContainerModel(KapsuleClient *client, QObject *parent = nullptr);
+
+    /**
+     * @brief Destructor.
+     */
+    ~ContainerModel() override;
+
+    [[nodiscard]] int rowCount(const QModelIndex &parent = {}) const override;
+    [[nodiscard]] QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    [[nodiscard]] QHash<int, QByteArray> roleNames() const override;
+
+    /**
+     * @brief Returns the container at @p row.
+     * @return The container, or an invalid container if out of range.
+     */
+    [[nodiscard]] Container container(int row) const;
+
+    /**
+     * @brief Returns the row of the container named @p name.
+     * @return The row, or -1 if there is no such container.
+     */
+    [[nodiscard]] int rowOf(const QString &name) const;
+
+    /**
+     * @brief Returns the coalescing interval in milliseconds.
+     */
+    [[nodiscard]] int coalesceInterval() const;
+
+    /**
+     * @brief Sets the coalescing interval in milliseconds.
+     *
+     * Change notifications within this interval of the first one are
+     * folded into a single update.
+     */
+    void setCoalesceInterval(int msec);
+
+public Q_SLOTS:
+    /**
+     * @brief Schedule an update from the client's container cache.
+     *
+     * Called automatically when the cache changes; there is normally no
+     * need to call it directly.
+     */
+    void refresh();
+
+Q_SIGNALS:
+    /**
+     * @brief Emitted when the number of rows changes.
+     */
+    void countChanged();
+
+    /**
+     * @brief Emitted when the coalescing interval changes.
+     */
+    void coalesceIntervalChanged();
+
+private:
+    std::unique_ptr<ContainerModelPrivate> d;
+    friend class ContainerModelPrivate;
+};
+
+} // namespace Kapsule
+
+#endif // KAPSULE_CONTAINERMODEL_H
@@ -0,0 +1,140 @@
+/*
+    SPDX-FileCopyrightText: 2024-2026 KDE Community
+    SPDX-License-Identifier: LGPL-2.1-or-later
+*/
+
+#include "containerstats.h"
+
+#include <QDBusArgument>
+#include <QSharedData>
+
+namespace Kapsule {
+
+// ============================================================================
+// ContainerStatsData (implicitly shared)
+// ============================================================================
+
+class ContainerStatsData : public QSharedData
+{
+public:
+    QString name;
+    qint64 cpuTime = 0;
+    qint64 memoryUsage = 0;
+    qint64 memoryLimit = 0;
+    qint64 swapUsage = 0;
+    qint64 diskUsage = 0;
+    qint64 bytesReceived = 0;
+    qint64 bytesSent = 0;
+    int processCount = 0;
+};
+
+// ============================================================================
+// ContainerStats implementation
+// ============================================================================
+
+ContainerStats::ContainerStats()
+    : d(new ContainerStatsData)
+{
+}
+
+ContainerStats::ContainerStats(const ContainerStats &other) = default;
+ContainerStats::ContainerStats(ContainerStats &&other) noexcept = default;
+ContainerStats::~ContainerStats() = default;
+ContainerStats &ContainerStats::operator=(const ContainerStats &other) = default;
+ContainerStats &ContainerStats::operator=(ContainerStats &&other) noexcept = default;
+
+bool ContainerStats::isValid() const
+{
+    return !d->name.isEmpty();
+}
+
+QString ContainerStats::name() const
+{
+    return d->name;
+}
+
+qint64 ContainerStats::cpuTime() const
+{
+    return d->cpuTime;
+}
+
+qint64 ContainerStats::memoryUsage() const
+{
+    return d->memoryUsage;
+}
+
+qint64 ContainerStats::memoryLimit() const
+{
+    return d->memoryLimit;
+}
+
+qint64 ContainerStats::swapUsage() const
+{
+    return d->swapUsage;
+}
+
+qint64 ContainerStats::diskUsage() const
+{
+    return d->diskUsage;
+}
+
+qint64 ContainerStats::bytesReceived() const
+{
+    return d->bytesReceived;
+}
+
+qint64 ContainerStats::bytesSent() const
+{
+    return d->bytesSent;
+}
+
+int ContainerStats::processCount() const
+{
+    return d->processCount;
+}
+
+// ============================================================================
+// D-Bus streaming operators
+// ============================================================================
+
+QDBusArgument &operator<<(QDBusArgument &arg, const ContainerStats &stats)
+{
+    arg.beginStructure();
+    arg << stats.d->name
+        << stats.d->cpuTime
+        << stats.d->memoryUsage
+        << stats.d->memoryLimit
+        << stats.d->swapUsage
+        << stats.d->diskUsage
+        << stats.d->bytesReceived
+        << stats.d->bytesSent
+        << stats.d->processCount;
+    arg.endStructure();
+    return arg;
+}
+
+const QDBusArgument &operator>>(const QDBusArgument &arg, ContainerStats &stats)
+{
+    QString name;
+    qint64 cpuTime = 0, memoryUsage = 0, memoryLimit = 0, swapUsage = 0;
+    qint64 diskUsage = 0, bytesReceived = 0, bytesSent = 0;
+    int processCount = 0;
+    arg.beginStructure();
+    arg >> name >> cpuTime >> memoryUsage >> memoryLimit >> swapUsage
+        >> diskUsage >> bytesReceived >> bytesSent >> processCount;
+    arg.endStructure();
+
+    stats.d->name = name;
+    stats.d->cpuTime = cpuTime;
+    stats.d->memoryUsage = memoryUsage;
+    stats.d->memoryLimit = memoryLimit;
+    stats.d->swapUsage = swapUsage;
+    stats.d->diskUsage = diskUsage;
+    stats.d->bytesReceived = bytesReceived;
+    stats.d->bytesSent = bytesSent;
+    stats.d->processCount = processCount;
+
+    return arg;
+}
+
+} // namespace Kapsule
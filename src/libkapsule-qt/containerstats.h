@@ -0,0 +1,153 @@
+/*
+    SPDX-FileCopyrightText: 2024-2026 KDE Community
+    SPDX-License-Identifier: LGPL-2.1-or-later
+*/
+
+#ifndef KAPSULE_CONTAINERSTATS_H
+#define KAPSULE_CONTAINERSTATS_H
+
+#include <QObject>
+#include <QString>
+#include <QSharedDataPointer>
+
+#include "kapsule_export.h"
+
+class QDBusArgument;
+
+namespace Kapsule {
+
+class ContainerStatsData;
+
+/**
+ * @class ContainerStats
+ * @brief A sample of a running container's resource usage.
+ *
+ * CPU time and network counters are cumulative since the container
+ * started; rates (such as CPU percentage) are computed from two samples.
+ *
+ * ContainerStats objects are implicitly shared.
+ *
+ * @since 0.2
+ */
+class KAPSULE_EXPORT ContainerStats
+{
+    Q_GADGET
+
+    Q_PROPERTY(QString name READ name)
+    Q_PROPERTY(qint64 cpuTime READ cpuTime)
+    Q_PROPERTY(qint64 memoryUsage READ memoryUsage)
+    Q_PROPERTY(qint64 memoryLimit READ memoryLimit)
+    Q_PROPERTY(qint64 swapUsage READ swapUsage)
+    Q_PROPERTY(qint64 diskUsage READ diskUsage)
+    Q_PROPERTY(qint64 bytesReceived READ bytesReceived)
+    Q_PROPERTY(qint64 bytesSent READ bytesSent)
+    Q_PROPERTY(int processCount READ processCount)
+
+public:
+    /**
+     * @brief Constructs an invalid sample.
+     */
+    ContainerStats();
+
+    /**
+     * @brief Copy constructor.
+     */
+    ContainerStats(const ContainerStats &other);
+
+    /**
+     * @brief Move constructor.
+     */
+    ContainerStats(ContainerStats &&other) noexcept;
+
+    /**
+     * @brief Destructor.
+     */
+    ~ContainerStats();
+
+    /**
+     * @brief Copy assignment operator.
+     */
+    ContainerStats &operator=(const ContainerStats &other);
+
+    /**
+     * @brief Move assignment operator.
+     */
+    ContainerStats &operator=(ContainerStats &&other) noexcept;
+
+    /**
+     * @brief Returns whether this sample is valid.
+     * @return true if valid, false otherwise (e.g. the container is not running).
+     */
+    [[nodiscard]] bool isValid() const;
+
+    /**
+     * @brief Returns the container name.
+     * @return The name.
+     */
+    [[nodiscard]] QString name() const;
+
+    /**
+     * @brief Returns the CPU time used by the container.
+     * @return Cumulative CPU time in nanoseconds.
+     */
+    [[nodiscard]] qint64 cpuTime() const;
+
+    /**
+     * @brief Returns the memory currently used by the container.
+     * @return Memory usage in bytes.
+     */
+    [[nodiscard]] qint64 memoryUsage() const;
+
+    /**
+     * @brief Returns the memory available to the container.
+     * @return The container's memory limit, or the host's total memory
+     *         if it has none, in bytes.
+     */
+    [[nodiscard]] qint64 memoryLimit() const;
+
+    /**
+     * @brief Returns the swap currently used by the container.
+     * @return Swap usage in bytes.
+     */
+    [[nodiscard]] qint64 swapUsage() const;
+
+    /**
+     * @brief Returns the disk space used by the container.
+     * @return Disk usage in bytes, summed over its disks.
+     */
+    [[nodiscard]] qint64 diskUsage() const;
+
+    /**
+     * @brief Returns the bytes received over the network.
+     * @return Cumulative bytes, excluding loopback.
+     */
+    [[nodiscard]] qint64 bytesReceived() const;
+
+    /**
+     * @brief Returns the bytes sent over the network.
+     * @return Cumulative bytes, excluding loopback.
+     */
+    [[nodiscard]] qint64 bytesSent() const;
+
+    /**
+     * @brief Returns the number of processes in the container.
+     * @return The process count.
+     */
+    [[nodiscard]] int processCount() const;
+
+private:
+    QSharedDataPointer<ContainerStatsData> d;
+
+    friend KAPSULE_EXPORT QDBusArgument &operator<<(QDBusArgument &arg, const ContainerStats &stats);
+    friend KAPSULE_EXPORT const QDBusArgument &operator>>(const QDBusArgument &arg, ContainerStats &stats);
+};
+
+// D-Bus argument streaming operators for ContainerStats (sxxxxxxxi)
+KAPSULE_EXPORT QDBusArgument &operator<<(QDBusArgument &arg, const ContainerStats &stats);
+KAPSULE_EXPORT const QDBusArgument &operator>>(const QDBusArgument &arg, ContainerStats &stats);
+
+} // namespace Kapsule
+
+Q_DECLARE_METATYPE(Kapsule::ContainerStats)
+
+#endif // KAPSULE_CONTAINERSTATS_H
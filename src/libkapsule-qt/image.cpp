@@ -0,0 +1,116 @@
+/*
+    SPDX-FileCopyrightText: 2024-2026 KDE Community
+    SPDX-License-Identifier: LGPL-2.1-or-later
+*/
+
+#include "image.h"
+
+#include <QDBusArgument>
+#include <QSharedData>
+
+namespace Kapsule {
+
+// ============================================================================
+// ImageData (implicitly shared)
+// ============================================================================
+
+class ImageData : public QSharedData
+{
+public:
+    QString fingerprint;
+    QStringList aliases;
+    QString description;
+    qint64 size = 0;
+    QDateTime uploaded;
+};
+
+// ============================================================================
+// Image implementation
+// ============================================================================
+
+Image::Image()
+    : d(new ImageData)
+{
+}
+
+Image::Image(const Image &other) = default;
+Image::Image(Image &&other) noexcept = default;
+Image::~Image() = default;
+Image &Image::operator=(const Image &other) = default;
+Image &Image::operator=(Image &&other) noexcept = default;
+
+bool Image::isValid() const
+{
+    return !d->fingerprint.isEmpty();
+}
+
+QString Image::fingerprint() const
+{
+    return d->fingerprint;
+}
+
+QStringList Image::aliases() const
+{
+    return d->aliases;
+}
+
+QString Image::description() const
+{
+    return d->description;
+}
+
+qint64 Image::size() const
+{
+    return d->size;
+}
+
+QDateTime Image::uploaded() const
+{
+    return d->uploaded;
+}
+
+bool Image::operator==(const Image &other) const
+{
+    return d->fingerprint == other.d->fingerprint;
+}
+
+bool Image::operator!=(const Image &other) const
+{
+    return !(*this == other);
+}
+
+// ============================================================================
+// D-Bus streaming operators
+// ============================================================================
+
+QDBusArgument &operator<<(QDBusArgument &arg, const Image &image)
+{
+    arg.beginStructure();
+    arg << image.d->fingerprint
+        << image.d->aliases
+        << image.d->description
+        << image.d->size
+        << image.d->uploaded.toString(Qt::ISODate);
+    arg.endStructure();
+    return arg;
+}
+
+const QDBusArgument &operator>>(const QDBusArgument &arg, Image &image)
+{
+    QString fingerprint, description, uploaded;
+    QStringList aliases;
+    qint64 size = 0;
+    arg.beginStructure();
+    arg >> fingerprint >> aliases >> description >> size >> uploaded;
+    arg.endStructure();
+
+    image.d->fingerprint = fingerprint;
+    image.d->aliases = aliases;
+    image.d->description = description;
+    image.d->size = size;
+    image.d->uploaded = QDateTime::fromString(uploaded, Qt::ISODate);
+
+    return arg;
+}
+
+} // namespace Kapsule
@@ -0,0 +1,133 @@
+/*
+    SPDX-FileCopyrightText: 2024-2026 KDE Community
+    SPDX-License-Identifier: LGPL-2.1-or-later
+*/
+
+#ifndef KAPSULE_IMAGE_H
+#define KAPSULE_IMAGE_H
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QDateTime>
+#include <QSharedDataPointer>
+
+#include "kapsule_export.h"
+
+class QDBusArgument;
+
+namespace Kapsule {
+
+class ImageData;
+
+/**
+ * @class Image
+ * @brief Represents an image in the local Incus image store.
+ *
+ * Image objects are implicitly shared.
+ *
+ * @since 0.2
+ */
+class KAPSULE_EXPORT Image
+{
+    Q_GADGET
+
+    Q_PROPERTY(QString fingerprint READ fingerprint)
+    Q_PROPERTY(QStringList aliases READ aliases)
+    Q_PROPERTY(QString description READ description)
+    Q_PROPERTY(qint64 size READ size)
+    Q_PROPERTY(QDateTime uploaded READ uploaded)
+
+public:
+    /**
+     * @brief Constructs an invalid image.
+     */
+    Image();
+
+    /**
+     * @brief Copy constructor.
+     */
+    Image(const Image &other);
+
+    /**
+     * @brief Move constructor.
+     */
+    Image(Image &&other) noexcept;
+
+    /**
+     * @brief Destructor.
+     */
+    ~Image();
+
+    /**
+     * @brief Copy assignment operator.
+     */
+    Image &operator=(const Image &other);
+
+    /**
+     * @brief Move assignment operator.
+     */
+    Image &operator=(Image &&other) noexcept;
+
+    /**
+     * @brief Returns whether this image object is valid.
+     * @return true if valid, false otherwise.
+     */
+    [[nodiscard]] bool isValid() const;
+
+    /**
+     * @brief Returns the full SHA-256 fingerprint of the image.
+     * @return The fingerprint.
+     */
+    [[nodiscard]] QString fingerprint() const;
+
+    /**
+     * @brief Returns the local aliases pointing at this image.
+     * @return The alias names, possibly empty.
+     */
+    [[nodiscard]] QStringList aliases() const;
+
+    /**
+     * @brief Returns the image description.
+     * @return The description (e.g., "Arch Linux current amd64").
+     */
+    [[nodiscard]] QString description() const;
+
+    /**
+     * @brief Returns the size of the image in bytes.
+     * @return The size, or 0 if unknown.
+     */
+    [[nodiscard]] qint64 size() const;
+
+    /**
+     * @brief Returns when the image was added to the local store.
+     * @return The upload timestamp.
+     */
+    [[nodiscard]] QDateTime uploaded() const;
+
+    /**
+     * @brief Comparison operator.
+     */
+    bool operator==(const Image &other) const;
+
+    /**
+     * @brief Inequality operator.
+     */
+    bool operator!=(const Image &other) const;
+
+private:
+    QSharedDataPointer<ImageData> d;
+
+    friend KAPSULE_EXPORT QDBusArgument &operator<<(QDBusArgument &arg, const Image &image);
+    friend KAPSULE_EXPORT const QDBusArgument &operator>>(const QDBusArgument &arg, Image &image);
+};
+
+// D-Bus argument streaming operators for Image (sassxs)
+KAPSULE_EXPORT QDBusArgument &operator<<(QDBusArgument &arg, const Image &image);
+KAPSULE_EXPORT const QDBusArgument &operator>>(const QDBusArgument &arg, Image &image);
+
+} // namespace Kapsule
+
+Q_DECLARE_METATYPE(Kapsule::Image)
+
+#endif // KAPSULE_IMAGE_H
@@ -6,19 +6,64 @@
 #include "kapsuleclient.h"
 #include "kapsule_debug.h"
 #include "kapsulemanagerinterface.h"
-#include "kapsuleoperationinterface.h"
+#include "operationwatcher.h"
 #include "types.h"
 
+#include <QCoreApplication>
 #include <QDBusConnection>
+#include <QDBusMessage>
 #include <QDBusObjectPath>
 #include <QDBusPendingReply>
+#include <QDBusReply>
 #include <QDBusServiceWatcher>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QPointer>
+#include <QRegularExpression>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QThread>
+#include <QTimer>
+#include <QVersionNumber>
 
 #include <qcoro/qcorodbuspendingreply.h>
-#include <qcoro/qcorosignal.h>
+#include <qcoro/qcorotimer.h>
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <variant>
 
 namespace Kapsule {
 
+namespace {
+// First daemon version with ListContainersV2.
+const QVersionNumber kCompactContainersVersion(0, 3, 0);
+
+// Reconnect backoff while operations are waiting on a vanished daemon:
+// 0.25s doubling up to 8s, about 30s in total before giving up.
+constexpr std::chrono::milliseconds kReconnectInitialDelay{250};
+constexpr std::chrono::milliseconds kReconnectMaxDelay{8000};
+constexpr int kReconnectMaxAttempts = 8;
+
+// Wraps a progress callback so it calls @p mark first, whether or not
+// the caller set one.
+template<typename... Args>
+std::function<void(Args...)> markFirst(std::function<void(Args...)> callback,
+                                       const std::function<void()> &mark)
+{
+    return [callback = std::move(callback), mark](Args... args) {
+        mark();
+        if (callback) {
+            callback(args...);
+        }
+    };
+}
+}
+
 // ============================================================================
 // Private implementation
 // ============================================================================
@@ -30,16 +75,58 @@ public:
 
     void connectToDaemon();
     QCoro::Task<OperationResult> waitForOperation(
+        const char *method,
         const QString &objectPath,
         OperationCallbacks callbacks);
+    QCoro::Task<OperationResult> timedOperation(
+        QString method,
+        QString objectPath,
+        OperationCallbacks callbacks);
+
+    // A call's start time, taken only while statistics are enabled.
+    struct CallTimer {
+        const char *method = nullptr;
+        std::chrono::steady_clock::time_point start;
+    };
+    [[nodiscard]] CallTimer startCall(const char *method) const;
+    void finishCall(const CallTimer &timer);
 
     void setConnected(bool value);
+    void scheduleReconnect();
+    QCoro::Task<> resumeOperations();
+
+    // A delta signal seen while a cache load was in flight: the updated
+    // container, or the name of a removed one.
+    using CacheDelta = std::variant<Container, QString>;
+
+    QCoro::Task<bool> loadCache();
+    QCoro::Task<std::optional<QList<Container>>> fetchContainers();
+    QString createSchemaCachePath() const;
+    void updateCached(const Container &container);
+    void removeCached(const QString &name);
+    void applyToCache(const CacheDelta &delta);
 
     KapsuleClient *q_ptr;
     std::unique_ptr<OrgKdeKapsuleManagerInterface> interface;
     QDBusServiceWatcher serviceWatcher;
+    OperationWatcher operationWatcher;
+    QTimer reconnectTimer;
+    int reconnectAttempts = 0;
     QString daemonVersion;
+    uint createSchemaVersion = 0;
+    std::optional<CreateSchemaIndex> createSchema;
+    bool compactContainers = false;  // daemon has ListContainersV2
     bool connected = false;
+    // Set by the first loadContainerCache() call; clients that never use
+    // the cache don't pay for a container list on every (re)connect.
+    bool cacheWanted = false;
+    bool cacheLoaded = false;
+    QList<Container> cache;
+    // One buffer per cache load in flight, collecting the deltas to
+    // re-apply on top of its reply.
+    QList<QList<CacheDelta> *> pendingDeltas;
+    // Null while statistics are disabled, so that costs one check per call.
+    std::unique_ptr<ClientStatistics> statistics;
 };
 
 KapsuleClientPrivate::KapsuleClientPrivate(KapsuleClient *q)
@@ -48,18 +135,29 @@ KapsuleClientPrivate::KapsuleClientPrivate(KapsuleClient *q)
                      QDBusConnection::systemBus(),
                      QDBusServiceWatcher::WatchForRegistration
                          | QDBusServiceWatcher::WatchForUnregistration)
+    , operationWatcher(QDBusConnection::systemBus())
 {
     // Register D-Bus types before any D-Bus operations
     registerDBusTypes();
 
+    if (qEnvironmentVariableIntValue("KAPSULE_STATS") != 0) {
+        statistics = std::make_unique<ClientStatistics>();
+    }
+
     QObject::connect(&serviceWatcher, &QDBusServiceWatcher::serviceRegistered,
         q, [this](const QString &) { connectToDaemon(); });
     QObject::connect(&serviceWatcher, &QDBusServiceWatcher::serviceUnregistered,
         q, [this](const QString &) {
             qCDebug(KAPSULE_LOG) << "kapsule-daemon disappeared from the bus";
             setConnected(false);
+            scheduleReconnect();
         });
 
+    reconnectTimer.setSingleShot(true);
+    QObject::connect(&reconnectTimer, &QTimer::timeout, q, [this] {
+        connectToDaemon();
+    });
+
     connectToDaemon();
 }
 
@@ -76,115 +174,289 @@ void KapsuleClientPrivate::connectToDaemon()
         &OrgKdeKapsuleManagerInterface::ContainersChanged,
         q_ptr, &KapsuleClient::containersChanged);
 
-    // Read a property instead of checking isValid() — an actual D-Bus call
-    // triggers bus activation so the daemon starts via systemd if needed.
-    daemonVersion = interface->version();
-
-    if (interface->lastError().isValid()) {
+    // Keep the local container cache current from the daemon's deltas.
+    // These are always emitted before ContainersChanged, so the cache is
+    // up to date by the time that signal is forwarded.
+    QObject::connect(interface.get(),
+        &OrgKdeKapsuleManagerInterface::ContainerUpdated,
+        q_ptr, [this](const QString &name, const QString &state, const QString &image,
+                      const QString &created, const QString &mode) {
+            updateCached(Container::fromWire(name, state, image, created, mode));
+        });
+    QObject::connect(interface.get(),
+        &OrgKdeKapsuleManagerInterface::ContainerRemoved,
+        q_ptr, [this](const QString &name) { removeCached(name); });
+
+    // Read the properties instead of checking isValid() — an actual D-Bus
+    // call triggers bus activation so the daemon starts via systemd if
+    // needed.  One GetAll fetches everything the client keys caches on.
+    auto call = QDBusMessage::createMethodCall(interface->service(), interface->path(),
+        QStringLiteral("org.freedesktop.DBus.Properties"), QStringLiteral("GetAll"));
+    call << interface->interface();
+    const auto timer = startCall("GetAll");
+    const QDBusReply<QVariantMap> properties = interface->connection().call(call);
+    finishCall(timer);
+
+    if (!properties.isValid()) {
         qCWarning(KAPSULE_LOG) << "Failed to connect to kapsule-daemon:"
-                               << interface->lastError().message();
+                               << properties.error().message();
         setConnected(false);
+        scheduleReconnect();
     } else {
+        daemonVersion = properties.value().value(QStringLiteral("Version")).toString();
+        // Missing on daemons older than 0.3.0, which then get no schema cache
+        createSchemaVersion = properties.value().value(QStringLiteral("CreateSchemaVersion")).toUInt();
+        createSchema.reset();
         qCDebug(KAPSULE_LOG) << "Connected to kapsule-daemon version" << daemonVersion;
+        compactContainers = QVersionNumber::fromString(daemonVersion) >= kCompactContainersVersion;
+        reconnectTimer.stop();
+        reconnectAttempts = 0;
         setConnected(true);
+        if (cacheWanted) {
+            QCoro::connect(loadCache(), q_ptr, [](bool) {});
+        }
+
+        // Waits that outlived the previous daemon either continue with
+        // the operations it resumed or fail now instead of hanging.
+        if (operationWatcher.hasWaiters()) {
+            QCoro::connect(resumeOperations(), q_ptr, [] {});
+        }
     }
 }
 
-void KapsuleClientPrivate::setConnected(bool value)
+void KapsuleClientPrivate::scheduleReconnect()
 {
-    if (connected == value) {
+    // Without pending operations there is nothing to hurry for: the
+    // service watcher reconnects once the daemon is back on the bus.
+    if (connected || reconnectTimer.isActive() || !operationWatcher.hasWaiters()) {
         return;
     }
-    connected = value;
-    Q_EMIT q_ptr->connectedChanged(value);
+
+    if (reconnectAttempts >= kReconnectMaxAttempts) {
+        qCWarning(KAPSULE_LOG) << "Giving up on reconnecting to kapsule-daemon";
+        reconnectAttempts = 0;
+        operationWatcher.failAll(QStringLiteral("Lost connection to kapsule-daemon"));
+        return;
+    }
+
+    // Each attempt is a method call, which also bus-activates the daemon
+    // if it crashed rather than restarted.
+    const auto delay = std::min(kReconnectMaxDelay, kReconnectInitialDelay * (1 << reconnectAttempts));
+    ++reconnectAttempts;
+    qCDebug(KAPSULE_LOG) << "Reconnecting to kapsule-daemon in" << delay.count() << "ms";
+    reconnectTimer.start(delay);
 }
 
-QCoro::Task<OperationResult> KapsuleClientPrivate::waitForOperation(
-    const QString &objectPath,
-    OperationCallbacks callbacks)
+QCoro::Task<> KapsuleClientPrivate::resumeOperations()
 {
-    qCDebug(KAPSULE_LOG) << "Waiting for operation at" << objectPath;
-    
-    // Create a proxy for this specific operation
-    auto opProxy = std::make_unique<OrgKdeKapsuleOperationInterface>(
-        QStringLiteral("org.kde.kapsule"),
-        objectPath,
-        QDBusConnection::systemBus()
-    );
+    const auto timer = startCall("ListOperations");
+    auto reply = co_await interface->ListOperations();
+    finishCall(timer);
 
-    if (!opProxy->isValid()) {
-        qCWarning(KAPSULE_LOG) << "Operation proxy is invalid:" << opProxy->lastError().message();
-        co_return OperationResult{false, QStringLiteral("Failed to connect to operation object")};
-    }
-
-    qCDebug(KAPSULE_LOG) << "Operation proxy created successfully";
-
-    // -----------------------------------------------------------------------
-    // Race-condition guard: check if the operation already completed before
-    // we subscribe to the Completed signal.  The status() call is a
-    // synchronous D-Bus property Get — while the daemon handles this request
-    // its single-threaded asyncio loop cannot emit Completed, so the window
-    // between this check and the co_await below is safe.
-    // -----------------------------------------------------------------------
-    bool success = false;
-    QString error;
-
-    const QString currentStatus = opProxy->status();
-    qCDebug(KAPSULE_LOG) << "Current operation status:" << currentStatus;
-
-    if (currentStatus == QLatin1String("running")) {
-        // Subscribe to progress messages if handler provided
-        if (callbacks.onMessage) {
-            QObject::connect(
-                opProxy.get(),
-                &OrgKdeKapsuleOperationInterface::Message,
-                [cb = callbacks.onMessage](int type, const QString &msg, int indent) {
-                    qCDebug(KAPSULE_LOG) << "Got Message signal:" << type << msg;
-                    cb(static_cast<MessageType>(type), msg, indent);
-                });
-            qCDebug(KAPSULE_LOG) << "Subscribed to Message signal";
+    QStringList running;
+    if (reply.isError()) {
+        // Treat everything as finished or lost; the status of each
+        // operation still tells which.
+        qCWarning(KAPSULE_LOG) << "ListOperations failed:" << reply.error().message();
+    } else {
+        const QList<QDBusObjectPath> paths = reply.value();
+        for (const QDBusObjectPath &path : paths) {
+            running.append(path.path());
         }
+    }
 
-        if (callbacks.onProgressStart) {
-            QObject::connect(
-                opProxy.get(),
-                &OrgKdeKapsuleOperationInterface::ProgressStarted,
-                callbacks.onProgressStart);
-        }
+    co_await operationWatcher.reattach(running);
+}
 
-        if (callbacks.onProgressUpdate) {
-            QObject::connect(
-                opProxy.get(),
-                &OrgKdeKapsuleOperationInterface::ProgressUpdate,
-                callbacks.onProgressUpdate);
+QCoro::Task<bool> KapsuleClientPrivate::loadCache()
+{
+    // The daemon awaits Incus while building the reply, so a delta that
+    // arrives before the reply may describe a newer state than the reply
+    // does.  Deltas are in order among themselves, so re-applying every
+    // one seen since the request leaves each container at its latest state.
+    QList<CacheDelta> deltas;
+    pendingDeltas.append(&deltas);
+    const auto containers = co_await fetchContainers();
+    pendingDeltas.removeOne(&deltas);
+    if (!containers) {
+        co_return false;
+    }
+
+    cache = *containers;
+    for (const CacheDelta &delta : std::as_const(deltas)) {
+        applyToCache(delta);
+    }
+    cacheLoaded = true;
+    Q_EMIT q_ptr->containersChanged();
+    co_return true;
+}
+
+QCoro::Task<std::optional<QList<Container>>> KapsuleClientPrivate::fetchContainers()
+{
+    // The compact format saves parsing state, mode and creation time
+    // from strings for every container.
+    if (compactContainers) {
+        const auto timer = startCall("ListContainersV2");
+        auto reply = co_await interface->ListContainersV2();
+        finishCall(timer);
+        if (reply.isError()) {
+            qCWarning(KAPSULE_LOG) << "ListContainersV2 failed:" << reply.error().message();
+            co_return std::nullopt;
         }
 
-        if (callbacks.onProgressTextUpdate) {
-            QObject::connect(
-                opProxy.get(),
-                &OrgKdeKapsuleOperationInterface::ProgressTextUpdate,
-                callbacks.onProgressTextUpdate);
+        const QList<ContainerV2> rows = reply.value();
+        QList<Container> containers;
+        containers.reserve(rows.size());
+        for (const ContainerV2 &row : rows) {
+            containers.append(row.container);
         }
+        co_return containers;
+    }
+
+    const auto timer = startCall("ListContainers");
+    auto reply = co_await interface->ListContainers();
+    finishCall(timer);
+    if (reply.isError()) {
+        qCWarning(KAPSULE_LOG) << "ListContainers failed:" << reply.error().message();
+        co_return std::nullopt;
+    }
+    co_return reply.value();
+}
 
-        if (callbacks.onProgressComplete) {
-            QObject::connect(
-                opProxy.get(),
-                &OrgKdeKapsuleOperationInterface::ProgressCompleted,
-                callbacks.onProgressComplete);
+QString KapsuleClientPrivate::createSchemaCachePath() const
+{
+    // The version goes into a file name, so only accept plain versions.
+    static const QRegularExpression plainVersion(QStringLiteral("^[A-Za-z0-9._+-]+$"));
+    if (createSchemaVersion == 0 || !plainVersion.match(daemonVersion).hasMatch()) {
+        return {};
+    }
+    return QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation)
+        + QStringLiteral("/kapsule/create-schema-%1-v%2.json").arg(daemonVersion).arg(createSchemaVersion);
+}
+
+void KapsuleClientPrivate::updateCached(const Container &container)
+{
+    if (cacheWanted) {
+        for (QList<CacheDelta> *deltas : std::as_const(pendingDeltas)) {
+            deltas->append(container);
         }
+        applyToCache(container);
+    }
+    Q_EMIT q_ptr->containerUpdated(container);
+}
+
+void KapsuleClientPrivate::removeCached(const QString &name)
+{
+    if (!cacheWanted) {
+        Q_EMIT q_ptr->containerRemoved(name);
+        return;
+    }
+    for (QList<CacheDelta> *deltas : std::as_const(pendingDeltas)) {
+        deltas->append(name);
+    }
+    const auto before = cache.size();
+    applyToCache(name);
+    if (cache.size() != before) {
+        Q_EMIT q_ptr->containerRemoved(name);
+    }
+}
+
+void KapsuleClientPrivate::applyToCache(const CacheDelta &delta)
+{
+    if (const auto *removed = std::get_if<QString>(&delta)) {
+        cache.removeIf([&](const Container &c) {
+            return c.name() == *removed;
+        });
+        return;
+    }
 
-        qCDebug(KAPSULE_LOG) << "Waiting for Completed signal...";
-        std::tie(success, error) = co_await qCoro(
-            opProxy.get(),
-            &OrgKdeKapsuleOperationInterface::Completed);
+    const Container &container = std::get<Container>(delta);
+    auto it = std::find_if(cache.begin(), cache.end(), [&](const Container &c) {
+        return c.name() == container.name();
+    });
+    if (it != cache.end()) {
+        *it = container;
     } else {
-        // Operation already finished — read result from properties
-        success = (currentStatus == QLatin1String("completed"));
-        error = opProxy->errorMessage();
+        cache.append(container);
     }
+}
 
-    qCDebug(KAPSULE_LOG) << "Operation finished: success=" << success << "error=" << error;
-    co_return OperationResult{success, error};
+void KapsuleClientPrivate::setConnected(bool value)
+{
+    if (connected == value) {
+        return;
+    }
+    connected = value;
+    if (!connected) {
+        // Deltas missed while disconnected; reloaded on reconnect
+        cacheLoaded = false;
+    }
+    Q_EMIT q_ptr->connectedChanged(value);
+}
+
+KapsuleClientPrivate::CallTimer KapsuleClientPrivate::startCall(const char *method) const
+{
+    if (!statistics) {
+        return {};
+    }
+    return {method, std::chrono::steady_clock::now()};
+}
+
+void KapsuleClientPrivate::finishCall(const CallTimer &timer)
+{
+    // Statistics may have been turned off while the call was in flight.
+    if (!timer.method || !statistics) {
+        return;
+    }
+    statistics->calls[QString::fromLatin1(timer.method)].record(
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - timer.start));
+}
+
+QCoro::Task<OperationResult> KapsuleClientPrivate::waitForOperation(
+    const char *method,
+    const QString &objectPath,
+    OperationCallbacks callbacks)
+{
+    if (!statistics) {
+        return operationWatcher.watch(objectPath, std::move(callbacks));
+    }
+    return timedOperation(QString::fromLatin1(method), objectPath, std::move(callbacks));
+}
+
+QCoro::Task<OperationResult> KapsuleClientPrivate::timedOperation(
+    QString method,
+    QString objectPath,
+    OperationCallbacks callbacks)
+{
+    using Clock = std::chrono::steady_clock;
+    const auto start = Clock::now();
+    auto firstSignal = std::make_shared<std::optional<Clock::time_point>>();
+    const std::function<void()> mark = [firstSignal] {
+        if (!*firstSignal) {
+            *firstSignal = Clock::now();
+        }
+    };
+    callbacks.onMessage = markFirst(std::move(callbacks.onMessage), mark);
+    callbacks.onProgressStart = markFirst(std::move(callbacks.onProgressStart), mark);
+    callbacks.onProgressUpdate = markFirst(std::move(callbacks.onProgressUpdate), mark);
+    callbacks.onProgressTextUpdate = markFirst(std::move(callbacks.onProgressTextUpdate), mark);
+    callbacks.onProgressComplete = markFirst(std::move(callbacks.onProgressComplete), mark);
+
+    // Nothing above suspends, so the waiter is still registered before
+    // any of the operation's signals can be dispatched.
+    const OperationResult result = co_await operationWatcher.watch(objectPath, std::move(callbacks));
+
+    if (statistics) {
+        const auto sinceStart = [start](Clock::time_point end) {
+            return std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+        };
+        if (*firstSignal) {
+            statistics->operationFirstSignal[method].record(sinceStart(**firstSignal));
+        }
+        statistics->operationTotal[method].record(sinceStart(Clock::now()));
+    }
+    co_return result;
 }
 
 // ============================================================================
@@ -199,6 +471,27 @@ KapsuleClient::KapsuleClient(QObject *parent)
 
 KapsuleClient::~KapsuleClient() = default;
 
+KapsuleClient *KapsuleClient::forCurrentThread()
+{
+    static thread_local QPointer<KapsuleClient> client;
+    if (client) {
+        return client;
+    }
+
+    client = new KapsuleClient;
+    QCoreApplication *app = QCoreApplication::instance();
+    QThread *thread = QThread::currentThread();
+    if (app && thread == app->thread()) {
+        client->setParent(app);
+    } else {
+        // finished is emitted from the thread itself; the deferred delete
+        // then runs as the thread winds down, even without an event loop.
+        QObject::connect(thread, &QThread::finished, client, &QObject::deleteLater,
+                         Qt::DirectConnection);
+    }
+    return client;
+}
+
 bool KapsuleClient::isConnected() const
 {
     return d->connected;
@@ -209,16 +502,86 @@ QString KapsuleClient::daemonVersion() const
     return d->daemonVersion;
 }
 
+bool KapsuleClient::statisticsEnabled() const
+{
+    return d->statistics != nullptr;
+}
+
+void KapsuleClient::setStatisticsEnabled(bool enabled)
+{
+    if (!enabled) {
+        d->statistics.reset();
+    } else if (!d->statistics) {
+        d->statistics = std::make_unique<ClientStatistics>();
+    }
+}
+
+ClientStatistics KapsuleClient::statistics() const
+{
+    return d->statistics ? *d->statistics : ClientStatistics{};
+}
+
+void KapsuleClient::resetStatistics()
+{
+    if (d->statistics) {
+        *d->statistics = ClientStatistics{};
+    }
+}
+
+QCoro::Task<bool> KapsuleClient::loadContainerCache()
+{
+    d->cacheWanted = true;
+    if (d->cacheLoaded) {
+        co_return true;
+    }
+    if (!d->connected) {
+        co_return false;
+    }
+    co_return co_await d->loadCache();
+}
+
+QList<Container> KapsuleClient::cachedContainers() const
+{
+    return d->cache;
+}
+
 QCoro::Task<QList<Container>> KapsuleClient::listContainers()
 {
     if (!d->connected) {
         co_return {};
     }
 
-    // Call D-Bus method - Container is marshalled directly
-    auto reply = co_await d->interface->ListContainers();
+    auto containers = co_await d->fetchContainers();
+    co_return containers.value_or(QList<Container>{});
+}
+
+QCoro::Task<QList<Container>> KapsuleClient::listContainers(const ContainerFilter &filter)
+{
+    if (!d->connected) {
+        co_return {};
+    }
+
+    QVariantMap criteria;
+    if (!filter.states.isEmpty()) {
+        const auto stateEnum = QMetaEnum::fromType<Container::State>();
+        QStringList states;
+        for (Container::State state : filter.states) {
+            states.append(QString::fromLatin1(stateEnum.valueToKey(static_cast<int>(state))));
+        }
+        criteria.insert(QStringLiteral("states"), states);
+    }
+    if (!filter.name.isEmpty()) {
+        criteria.insert(QStringLiteral("name"), filter.name);
+    }
+    if (!filter.image.isEmpty()) {
+        criteria.insert(QStringLiteral("image"), filter.image);
+    }
+
+    const auto timer = d->startCall("QueryContainers");
+    auto reply = co_await d->interface->QueryContainers(criteria, filter.fields);
+    d->finishCall(timer);
     if (reply.isError()) {
-        qCWarning(KAPSULE_LOG) << "ListContainers failed:" << reply.error().message();
+        qCWarning(KAPSULE_LOG) << "QueryContainers failed:" << reply.error().message();
         co_return {};
     }
 
@@ -231,7 +594,9 @@ QCoro::Task<Container> KapsuleClient::container(const QString &name)
         co_return Container{};
     }
 
+    const auto timer = d->startCall("GetContainerInfo");
     auto reply = co_await d->interface->GetContainerInfo(name);
+    d->finishCall(timer);
     if (reply.isError()) {
         qCWarning(KAPSULE_LOG) << "GetContainerInfo failed:" << reply.error().message();
         co_return Container{};
@@ -240,13 +605,61 @@ QCoro::Task<Container> KapsuleClient::container(const QString &name)
     co_return reply.value();
 }
 
+QCoro::Task<ContainerStats> KapsuleClient::containerStats(const QString &name)
+{
+    if (!d->connected) {
+        co_return ContainerStats{};
+    }
+
+    const auto timer = d->startCall("GetContainerStats");
+    auto reply = co_await d->interface->GetContainerStats({name});
+    d->finishCall(timer);
+    if (reply.isError()) {
+        qCWarning(KAPSULE_LOG) << "GetContainerStats failed:" << reply.error().message();
+        co_return ContainerStats{};
+    }
+
+    const QList<ContainerStats> stats = reply.value();
+    co_return stats.isEmpty() ? ContainerStats{} : stats.first();
+}
+
+QCoro::Task<QList<ContainerStats>> KapsuleClient::allContainerStats()
+{
+    if (!d->connected) {
+        co_return {};
+    }
+
+    const auto timer = d->startCall("GetContainerStats");
+    auto reply = co_await d->interface->GetContainerStats({});
+    d->finishCall(timer);
+    if (reply.isError()) {
+        qCWarning(KAPSULE_LOG) << "GetContainerStats failed:" << reply.error().message();
+        co_return {};
+    }
+
+    co_return reply.value();
+}
+
+QCoro::AsyncGenerator<QList<ContainerStats>> KapsuleClient::watchContainerStats(
+    std::chrono::milliseconds interval)
+{
+    for (;;) {
+        const auto next = std::chrono::steady_clock::now() + interval;
+        QList<ContainerStats> sample = co_await allContainerStats();
+        co_yield sample;
+        co_await QCoro::sleepUntil(next);
+    }
+}
+
 QCoro::Task<QString> KapsuleClient::getCreateSchema()
 {
     if (!d->connected) {
         co_return {};
     }
 
+    const auto timer = d->startCall("GetCreateSchema");
     auto reply = co_await d->interface->GetCreateSchema();
+    d->finishCall(timer);
     if (reply.isError()) {
         qCWarning(KAPSULE_LOG) << "GetCreateSchema failed:" << reply.error().message();
         co_return {};
@@ -255,13 +668,61 @@ QCoro::Task<QString> KapsuleClient::getCreateSchema()
     co_return reply.value();
 }
 
+QCoro::Task<CreateSchema> KapsuleClient::createSchema()
+{
+    const CreateSchemaIndex index = co_await createSchemaIndex();
+    co_return index.schema();
+}
+
+QCoro::Task<CreateSchemaIndex> KapsuleClient::createSchemaIndex()
+{
+    if (d->createSchema) {
+        co_return *d->createSchema;
+    }
+
+    const QString cachePath = d->createSchemaCachePath();
+    if (!cachePath.isEmpty()) {
+        QFile file(cachePath);
+        if (file.open(QIODevice::ReadOnly)) {
+            CreateSchema schema = parseCreateSchema(QString::fromUtf8(file.readAll()));
+            if (schema.version != 0 && static_cast<uint>(schema.version) == d->createSchemaVersion) {
+                d->createSchema = CreateSchemaIndex(schema);
+                co_return *d->createSchema;
+            }
+            qCDebug(KAPSULE_LOG) << "Ignoring stale schema cache" << cachePath;
+        }
+    }
+
+    const QString json = co_await getCreateSchema();
+    CreateSchema schema = parseCreateSchema(json);
+    if (schema.version == 0) {
+        co_return CreateSchemaIndex(schema);
+    }
+    d->createSchema = CreateSchemaIndex(schema);
+
+    if (!cachePath.isEmpty() && static_cast<uint>(schema.version) == d->createSchemaVersion) {
+        QDir().mkpath(QFileInfo(cachePath).absolutePath());
+        QSaveFile file(cachePath);
+        if (file.open(QIODevice::WriteOnly)) {
+            file.write(json.toUtf8());
+            if (!file.commit()) {
+                qCDebug(KAPSULE_LOG) << "Failed to write schema cache" << cachePath;
+            }
+        }
+    }
+
+    co_return *d->createSchema;
+}
+
 QCoro::Task<QVariantMap> KapsuleClient::config()
 {
     if (!d->connected) {
         co_return {{QStringLiteral("error"), QStringLiteral("Not connected")}};
     }
 
+    const auto timer = d->startCall("GetConfig");
     auto reply = co_await d->interface->GetConfig();
+    d->finishCall(timer);
     if (reply.isError()) {
         co_return {{QStringLiteral("error"), reply.error().message()}};
     }
@@ -285,14 +746,16 @@ QCoro::Task<OperationResult> KapsuleClient::createContainer(
         co_return {false, QStringLiteral("Not connected to daemon")};
     }
 
+    const auto timer = d->startCall("CreateContainer");
     auto reply = co_await d->interface->CreateContainer(name, image, options);
+    d->finishCall(timer);
     if (reply.isError()) {
         co_return {false, reply.error().message()};
     }
 
     // The reply is the D-Bus object path for the operation - wait for completion
     QDBusObjectPath opPath = reply.value();
-    co_return co_await d->waitForOperation(opPath.path(), std::move(callbacks));
+    co_return co_await d->waitForOperation("CreateContainer", opPath.path(), std::move(callbacks));
 }
 
 QCoro::Task<OperationResult> KapsuleClient::deleteContainer(
@@ -304,13 +767,15 @@ QCoro::Task<OperationResult> KapsuleClient::deleteContainer(
         co_return {false, QStringLiteral("Not connected to daemon")};
     }
 
+    const auto timer = d->startCall("DeleteContainer");
     auto reply = co_await d->interface->DeleteContainer(name, force);
+    d->finishCall(timer);
     if (reply.isError()) {
         co_return {false, reply.error().message()};
     }
 
     QDBusObjectPath opPath = reply.value();
-    co_return co_await d->waitForOperation(opPath.path(), std::move(callbacks));
+    co_return co_await d->waitForOperation("DeleteContainer", opPath.path(), std::move(callbacks));
 }
 
 QCoro::Task<OperationResult> KapsuleClient::startContainer(
@@ -321,13 +786,15 @@ QCoro::Task<OperationResult> KapsuleClient::startContainer(
         co_return {false, QStringLiteral("Not connected to daemon")};
     }
 
+    const auto timer = d->startCall("StartContainer");
     auto reply = co_await d->interface->StartContainer(name);
+    d->finishCall(timer);
     if (reply.isError()) {
         co_return {false, reply.error().message()};
     }
 
     QDBusObjectPath opPath = reply.value();
-    co_return co_await d->waitForOperation(opPath.path(), std::move(callbacks));
+    co_return co_await d->waitForOperation("StartContainer", opPath.path(), std::move(callbacks));
 }
 
 QCoro::Task<OperationResult> KapsuleClient::stopContainer(
@@ -339,13 +806,74 @@ QCoro::Task<OperationResult> KapsuleClient::stopContainer(
         co_return {false, QStringLiteral("Not connected to daemon")};
     }
 
+    const auto timer = d->startCall("StopContainer");
     auto reply = co_await d->interface->StopContainer(name, force);
+    d->finishCall(timer);
     if (reply.isError()) {
         co_return {false, reply.error().message()};
     }
 
     QDBusObjectPath opPath = reply.value();
-    co_return co_await d->waitForOperation(opPath.path(), std::move(callbacks));
+    co_return co_await d->waitForOperation("StopContainer", opPath.path(), std::move(callbacks));
+}
+
+QCoro::Task<OperationResult> KapsuleClient::deleteContainers(
+    const QStringList &names,
+    bool force,
+    OperationCallbacks callbacks)
+{
+    if (!d->connected) {
+        co_return {false, QStringLiteral("Not connected to daemon")};
+    }
+
+    const auto timer = d->startCall("DeleteContainers");
+    auto reply = co_await d->interface->DeleteContainers(names, force);
+    d->finishCall(timer);
+    if (reply.isError()) {
+        co_return {false, reply.error().message()};
+    }
+
+    QDBusObjectPath opPath = reply.value();
+    co_return co_await d->waitForOperation("DeleteContainers", opPath.path(), std::move(callbacks));
+}
+
+QCoro::Task<OperationResult> KapsuleClient::startContainers(
+    const QStringList &names,
+    OperationCallbacks callbacks)
+{
+    if (!d->connected) {
+        co_return {false, QStringLiteral("Not connected to daemon")};
+    }
+
+    const auto timer = d->startCall("StartContainers");
+    auto reply = co_await d->interface->StartContainers(names);
+    d->finishCall(timer);
+    if (reply.isError()) {
+        co_return {false, reply.error().message()};
+    }
+
+    QDBusObjectPath opPath = reply.value();
+    co_return co_await d->waitForOperation("StartContainers", opPath.path(), std::move(callbacks));
+}
+
+QCoro::Task<OperationResult> KapsuleClient::stopContainers(
+    const QStringList &names,
+    bool force,
+    OperationCallbacks callbacks)
+{
+    if (!d->connected) {
+        co_return {false, QStringLiteral("Not connected to daemon")};
+    }
+
+    const auto timer = d->startCall("StopContainers");
+    auto reply = co_await d->interface->StopContainers(names, force);
+    d->finishCall(timer);
+    if (reply.isError()) {
+        co_return {false, reply.error().message()};
+    }
+
+    QDBusObjectPath opPath = reply.value();
+    co_return co_await d->waitForOperation("StopContainers", opPath.path(), std::move(callbacks));
 }
 
 QCoro::Task<EnterResult> KapsuleClient::prepareEnter(
@@ -357,8 +885,10 @@ QCoro::Task<EnterResult> KapsuleClient::prepareEnter(
         co_return {false, QStringLiteral("Not connected to daemon"), {}};
     }
 
+    const auto timer = d->startCall("PrepareEnter");
     auto reply = co_await d->interface->PrepareEnter(containerName, command,
                                                     workingDirectory);
+    d->finishCall(timer);
     if (reply.isError()) {
         co_return {false, reply.error().message(), {}};
     }
@@ -375,13 +905,15 @@ QCoro::Task<OperationResult> KapsuleClient::refreshImages(
         co_return {false, QStringLiteral("Not connected to daemon")};
     }
 
+    const auto timer = d->startCall("RefreshImages");
     auto reply = co_await d->interface->RefreshImages(image);
+    d->finishCall(timer);
     if (reply.isError()) {
         co_return {false, reply.error().message()};
     }
 
     QDBusObjectPath opPath = reply.value();
-    co_return co_await d->waitForOperation(opPath.path(), std::move(callbacks));
+    co_return co_await d->waitForOperation("RefreshImages", opPath.path(), std::move(callbacks));
 }
 
 QCoro::Task<OperationResult> KapsuleClient::importImage(
@@ -393,24 +925,28 @@ QCoro::Task<OperationResult> KapsuleClient::importImage(
         co_return {false, QStringLiteral("Not connected to daemon")};
     }
 
+    const auto timer = d->startCall("ImportImage");
     auto reply = co_await d->interface->ImportImage(path, alias);
+    d->finishCall(timer);
     if (reply.isError()) {
         co_return {false, reply.error().message()};
     }
 
     QDBusObjectPath opPath = reply.value();
-    co_return co_await d->waitForOperation(opPath.path(), std::move(callbacks));
+    co_return co_await d->waitForOperation("ImportImage", opPath.path(), std::move(callbacks));
 }
 
-QCoro::Task<QString> KapsuleClient::listImages()
+QCoro::Task<QList<Image>> KapsuleClient::listImages()
 {
     if (!d->connected) {
         co_return {};
     }
 
-    auto reply = co_await d->interface->ListImages();
+    const auto timer = d->startCall("ListImagesV2");
+    auto reply = co_await d->interface->ListImagesV2();
+    d->finishCall(timer);
     if (reply.isError()) {
-        qCWarning(KAPSULE_LOG) << "ListImages failed:" << reply.error().message();
+        qCWarning(KAPSULE_LOG) << "ListImagesV2 failed:" << reply.error().message();
         co_return {};
     }
 
@@ -425,13 +961,39 @@ QCoro::Task<OperationResult> KapsuleClient::deleteImage(
         co_return {false, QStringLiteral("Not connected to daemon")};
     }
 
+    const auto timer = d->startCall("DeleteImage");
     auto reply = co_await d->interface->DeleteImage(identifier);
+    d->finishCall(timer);
     if (reply.isError()) {
         co_return {false, reply.error().message()};
     }
 
     QDBusObjectPath opPath = reply.value();
-    co_return co_await d->waitForOperation(opPath.path(), std::move(callbacks));
+    co_return co_await d->waitForOperation("DeleteImage", opPath.path(), std::move(callbacks));
+}
+
+QCoro::Task<bool> KapsuleClient::cancelOperation(const QString &objectPath)
+{
+    if (!d->connected) {
+        co_return false;
+    }
+
+    co_return co_await d->operationWatcher.cancel(objectPath);
+}
+
+QCoro::Task<OperationResult> KapsuleClient::watchOperation(
+    const QString &objectPath,
+    OperationCallbacks callbacks)
+{
+    if (!d->connected) {
+        co_return {false, QStringLiteral("Not connected to daemon")};
+    }
+
+    // Signals sent after the Subscribe reply are dispatched only once
+    // the waiter is registered, and an operation that already finished
+    // is caught by the watcher's status query.
+    co_await d->operationWatcher.subscribe(objectPath);
+    co_return co_await d->waitForOperation("Subscribe", objectPath, std::move(callbacks));
 }
 
 } // namespace Kapsule
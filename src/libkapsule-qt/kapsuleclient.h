@@ -10,12 +10,16 @@
 #include <QString>
 #include <QList>
 #include <QVariantMap>
+#include <chrono>
 #include <memory>
 
+#include <qcoro/qcoroasyncgenerator.h>
 #include <qcoro/qcorotask.h>
 
 #include "kapsule_export.h"
 #include "container.h"
+#include "containerstats.h"
+#include "image.h"
 #include "types.h"
 
 namespace Kapsule {
@@ -43,6 +47,13 @@ class KapsuleClientPrivate;
  *     });
  * @endcode
  *
+ * KapsuleClient is reentrant but not thread-safe: an instance must only be
+ * used from the thread it was created on, whose event loop delivers its
+ * replies and signals.  Instances are cheap, since they all share the
+ * process's system bus connection, so code running on worker threads uses
+ * one client per thread (see forCurrentThread()) instead of marshalling
+ * calls back to the GUI thread.
+ *
  * @since 0.1
  */
 class KAPSULE_EXPORT KapsuleClient : public QObject
@@ -73,6 +84,26 @@ public:
      */
     ~KapsuleClient() override;
 
+    /**
+     * @brief Returns a client owned by the calling thread.
+     *
+     * The client is created on first use and reused by later calls on the
+     * same thread.  It is deleted with the application on the main thread,
+     * and when the thread finishes on threads started with QThread or
+     * QThreadPool.  Threads without a running event loop await its
+     * coroutines with QCoro::waitFor():
+     *
+     * @code
+     * QThreadPool::globalInstance()->start([] {
+     *     KapsuleClient *client = KapsuleClient::forCurrentThread();
+     *     const auto containers = QCoro::waitFor(client->listContainers());
+     * });
+     * @endcode
+     *
+     * @return The calling thread's client; never null.
+     */
+    static KapsuleClient *forCurrentThread();
+
     /**
      * @brief Returns whether the client is connected to the daemon.
      * @return true if connected, false otherwise.
@@ -85,6 +116,37 @@ public:
      */
     [[nodiscard]] QString daemonVersion() const;
 
+    // =========================================================================
+    // Statistics
+    // =========================================================================
+
+    /**
+     * @brief Returns whether call latencies are being recorded.
+     *
+     * Off by default, unless the KAPSULE_STATS environment variable is set
+     * to a non-zero number when the client is created.
+     */
+    [[nodiscard]] bool statisticsEnabled() const;
+
+    /**
+     * @brief Start or stop recording call latencies.
+     *
+     * While disabled, calls don't read the clock at all.  Disabling also
+     * discards what was recorded so far.
+     */
+    void setStatisticsEnabled(bool enabled);
+
+    /**
+     * @brief Returns the latencies recorded since statistics were enabled.
+     * @return Per-method histograms, empty if statistics are disabled.
+     */
+    [[nodiscard]] ClientStatistics statistics() const;
+
+    /**
+     * @brief Discard the recorded latencies, keeping statistics enabled.
+     */
+    void resetStatistics();
+
     // =========================================================================
     // Coroutine-based API
     // =========================================================================
@@ -95,6 +157,41 @@ public:
      */
     QCoro::Task<QList<Container>> listContainers();
 
+    /**
+     * @brief List the containers matching @p filter.
+     *
+     * The filtering happens in the daemon, so this is much cheaper than
+     * listing all containers when only a few (e.g. the running ones) or
+     * only their names are needed.
+     *
+     * @param filter The states, name glob, image and fields to select.
+     * @return List of matching Container objects.
+     */
+    QCoro::Task<QList<Container>> listContainers(const ContainerFilter &filter);
+
+    /**
+     * @brief Start maintaining the local container cache.
+     *
+     * The first call fetches the container list; the cache is then
+     * reloaded on every reconnect and kept current from the daemon's
+     * ContainerUpdated and ContainerRemoved signals, so reading it never
+     * makes a D-Bus call.  Later calls return at once while the cache is
+     * loaded.  Clients that never call this don't maintain a cache.
+     * Each load is announced with containersChanged().
+     *
+     * @return false if the daemon is unreachable or the list call failed.
+     */
+    QCoro::Task<bool> loadContainerCache();
+
+    /**
+     * @brief Returns the locally cached container list.
+     *
+     * Empty until loadContainerCache() has finished.
+     *
+     * @return The cached containers, in daemon order with new ones appended.
+     */
+    [[nodiscard]] QList<Container> cachedContainers() const;
+
     /**
      * @brief Get a specific container by name.
      * @param name The container name.
@@ -102,6 +199,42 @@ public:
      */
     QCoro::Task<Container> container(const QString &name);
 
+    /**
+     * @brief Sample the resource usage of a container.
+     * @param name The container name.
+     * @return The sample, or an invalid one if the container is not running.
+     */
+    QCoro::Task<ContainerStats> containerStats(const QString &name);
+
+    /**
+     * @brief Sample the resource usage of every running container.
+     *
+     * The daemon reads all states in one batch, so this costs about the
+     * same as sampling a single container.
+     *
+     * @return One sample per running container.
+     */
+    QCoro::Task<QList<ContainerStats>> allContainerStats();
+
+    /**
+     * @brief Sample every running container at a fixed interval.
+     *
+     * Yields allContainerStats() immediately and then once per
+     * @p interval (measured from the start of each sample) for as long
+     * as the generator is iterated.  Destroy it to stop sampling.
+     *
+     * @code
+     * auto stream = client.watchContainerStats(std::chrono::seconds(1));
+     * QCORO_FOREACH(const QList<ContainerStats> &sample, stream) {
+     *     // render...
+     * }
+     * @endcode
+     *
+     * @param interval Time between samples.
+     */
+    QCoro::AsyncGenerator<QList<ContainerStats>> watchContainerStats(
+        std::chrono::milliseconds interval);
+
     /**
      * @brief Get the option schema for container creation.
      *
@@ -114,6 +247,28 @@ public:
      */
     QCoro::Task<QString> getCreateSchema();
 
+    /**
+     * @brief Get the parsed option schema for container creation.
+     *
+     * The schema is cached in memory and on disk, keyed by the daemon's
+     * Version and CreateSchemaVersion properties (read when connecting),
+     * so usually no D-Bus call is made.  Daemons older than 0.3.0 don't
+     * report a schema version and are always asked.
+     *
+     * @return The schema, or one with version 0 on error.
+     */
+    QCoro::Task<CreateSchema> createSchema();
+
+    /**
+     * @brief Get the create schema indexed by option key and CLI flag.
+     *
+     * Cached together with createSchema(), so the index is built once
+     * per schema version rather than for every lookup.
+     *
+     * @return The index; its schema has version 0 on error.
+     */
+    QCoro::Task<CreateSchemaIndex> createSchemaIndex();
+
     /**
      * @brief Get user configuration from daemon.
      * @return Map of config keys to values.
@@ -127,8 +282,7 @@ public:
      * that differ from the schema defaults need to be included;
      * the daemon fills in defaults for any omitted keys.
      *
-     * Use getCreateSchema() + parseCreateSchema() to discover
-     * available options at runtime.
+     * Use createSchema() to discover available options at runtime.
      *
      * @param name The name for the new container.
      * @param image The base image to use (e.g., "ubuntu:24.04"), empty for default.
@@ -176,6 +330,45 @@ public:
         bool force = false,
         OperationCallbacks callbacks = {});
 
+    /**
+     * @brief Delete several containers as one operation.
+     *
+     * The daemon removes the containers in parallel and reports each one
+     * as an indented message.  One container failing does not stop the
+     * others, but makes the whole operation fail.
+     *
+     * @param names The container names.
+     * @param force Force removal of running containers.
+     * @param callbacks Optional callbacks for progress messages and progress bars.
+     * @return Operation result with success/error info.
+     */
+    QCoro::Task<OperationResult> deleteContainers(
+        const QStringList &names,
+        bool force = false,
+        OperationCallbacks callbacks = {});
+
+    /**
+     * @brief Start several containers as one operation.
+     * @param names The container names.
+     * @param callbacks Optional callbacks for progress messages and progress bars.
+     * @return Operation result with success/error info.
+     */
+    QCoro::Task<OperationResult> startContainers(
+        const QStringList &names,
+        OperationCallbacks callbacks = {});
+
+    /**
+     * @brief Stop several containers as one operation.
+     * @param names The container names.
+     * @param force Force stop the containers.
+     * @param callbacks Optional callbacks for progress messages and progress bars.
+     * @return Operation result with success/error info.
+     */
+    QCoro::Task<OperationResult> stopContainers(
+        const QStringList &names,
+        bool force = false,
+        OperationCallbacks callbacks = {});
+
     /**
      * @brief Prepare to enter a container.
      *
@@ -227,13 +420,9 @@ public:
 
     /**
      * @brief List all images known to the local Incus daemon.
-     *
-     * Returns a JSON string with an array of image objects.
-     * The caller is responsible for parsing the JSON.
-     *
-     * @return JSON string with the image list, or empty string on error.
+     * @return List of Image objects, empty on error.
      */
-    QCoro::Task<QString> listImages();
+    QCoro::Task<QList<Image>> listImages();
 
     /**
      * @brief Delete an image by alias or fingerprint.
@@ -249,6 +438,37 @@ public:
         const QString &identifier,
         OperationCallbacks callbacks = {});
 
+    /**
+     * @brief Cancel a running operation.
+     *
+     * The object path is passed to OperationCallbacks::onStarted when
+     * the operation begins.  The awaiting call then finishes with a
+     * failed OperationResult once the daemon has stopped the work,
+     * including any Incus operation (such as an image download) it
+     * was waiting on.
+     *
+     * @param objectPath D-Bus path of the operation object.
+     * @return true if the operation was running and is being cancelled,
+     *         false if it had already finished or could not be reached.
+     */
+    QCoro::Task<bool> cancelOperation(const QString &objectPath);
+
+    /**
+     * @brief Follow an operation started by another client.
+     *
+     * Operation signals are only sent to the client that started the
+     * operation.  This subscribes to them first (for example to show
+     * operations listed by the daemon in a job tracker), then waits
+     * like the other operation methods.
+     *
+     * @param objectPath D-Bus path of the operation object.
+     * @param callbacks Optional callbacks for progress messages and progress bars.
+     * @return Operation result with success/error info.
+     */
+    QCoro::Task<OperationResult> watchOperation(
+        const QString &objectPath,
+        OperationCallbacks callbacks = {});
+
 Q_SIGNALS:
     /**
      * @brief Emitted when the connection state changes.
@@ -259,11 +479,25 @@ Q_SIGNALS:
     /**
      * @brief Emitted when the container list changes.
      *
-     * Fired after a container is created, deleted, started, or stopped.
-     * Clients should re-fetch the container list when this signal is received.
+     * Fired after a container is created, deleted, started, or stopped,
+     * and after cachedContainers() has been (re)loaded.
+     * Clients can read cachedContainers() when this signal is received,
+     * or use ContainerModel, which applies changes incrementally.
      */
     void containersChanged();
 
+    /**
+     * @brief Emitted when a container in the cache was added or changed.
+     * @param container The container's new state.
+     */
+    void containerUpdated(const Kapsule::Container &container);
+
+    /**
+     * @brief Emitted when a container was removed from the cache.
+     * @param name The name of the deleted container.
+     */
+    void containerRemoved(const QString &name);
+
 private:
     std::unique_ptr<KapsuleClientPrivate> d;
 };
@@ -0,0 +1,38 @@
+/*
+    SPDX-FileCopyrightText: 2024-2026 KDE Community
+    SPDX-License-Identifier: LGPL-2.1-or-later
+*/
+
+#ifndef KAPSULE_DBUSTYPES_H
+#define KAPSULE_DBUSTYPES_H
+
+// Included by the generated Manager interface proxy, which only takes a
+// single header: pulls in every Kapsule type used in its signatures.
+
+#include "container.h"
+#include "containerstats.h"
+#include "image.h"
+#include "types.h"
+
+namespace Kapsule {
+
+/**
+ * A Container in the compact v2 wire format, (sisxia{sv}): name, state
+ * and mode as enum values, creation time as a Unix timestamp, and a map
+ * of optional extra fields.  Returned by ListContainersV2, which the
+ * daemon has from version 0.3.0.
+ *
+ * @internal
+ */
+struct ContainerV2 {
+    Container container;
+};
+
+QDBusArgument &operator<<(QDBusArgument &arg, const ContainerV2 &container);
+const QDBusArgument &operator>>(const QDBusArgument &arg, ContainerV2 &container);
+
+} // namespace Kapsule
+
+Q_DECLARE_METATYPE(Kapsule::ContainerV2)
+
+#endif // KAPSULE_DBUSTYPES_H
@@ -0,0 +1,254 @@
+/*
+    SPDX-FileCopyrightText: 2024-2026 KDE Community
+    SPDX-License-Identifier: LGPL-2.1-or-later
+*/
+
+#include "operationwatcher.h"
+#include "kapsule_debug.h"
+
+#include <QDBusMessage>
+#include <QDBusPendingReply>
+#include <QScopeGuard>
+
+#include <qcoro/qcorodbuspendingreply.h>
+
+#include <coroutine>
+#include <optional>
+#include <utility>
+
+namespace Kapsule {
+
+namespace {
+const QString kService = QStringLiteral("org.kde.kapsule");
+const QString kOperationInterface = QStringLiteral("org.kde.kapsule.Operation");
+}
+
+// ============================================================================
+// Waiter bookkeeping
+// ============================================================================
+
+struct OperationWatcher::Waiter {
+    OperationCallbacks callbacks;
+    std::optional<OperationResult> result;
+    std::coroutine_handle<> continuation;
+};
+
+// Suspends until finish() stores a result for the waiter.
+struct OperationWatcher::Awaiter {
+    Waiter *waiter;
+
+    bool await_ready() const noexcept
+    {
+        return waiter->result.has_value();
+    }
+
+    void await_suspend(std::coroutine_handle<> handle) noexcept
+    {
+        waiter->continuation = handle;
+    }
+
+    OperationResult await_resume() const
+    {
+        return *waiter->result;
+    }
+};
+
+// ============================================================================
+// OperationWatcher implementation
+// ============================================================================
+
+OperationWatcher::OperationWatcher(const QDBusConnection &bus, QObject *parent)
+    : QObject(parent)
+    , m_bus(bus)
+{
+    // An empty path and member match every signal on the Operation
+    // interface, which only the daemon's operation objects implement.
+    // This is a single match rule for the lifetime of the client.
+    const bool ok = m_bus.connect(kService, QString(), kOperationInterface, QString(),
+                                  this, SLOT(handleSignal(QDBusMessage)));
+    if (!ok) {
+        qCWarning(KAPSULE_LOG) << "Failed to subscribe to operation signals:"
+                               << m_bus.lastError().message();
+    }
+}
+
+OperationWatcher::~OperationWatcher() = default;
+
+QCoro::Task<OperationResult> OperationWatcher::watch(QString objectPath,
+                                                     OperationCallbacks callbacks)
+{
+    qCDebug(KAPSULE_LOG) << "Waiting for operation at" << objectPath;
+
+    // Register before the first suspension point: signals for this path
+    // may already be queued behind the reply that gave us the path.
+    Waiter waiter{std::move(callbacks), std::nullopt, {}};
+    m_waiters.insert(objectPath, &waiter);
+    const auto unregister = qScopeGuard([&] {
+        m_waiters.remove(objectPath, &waiter);
+    });
+
+    if (waiter.callbacks.onStarted) {
+        waiter.callbacks.onStarted(objectPath);
+    }
+
+    // The operation may have finished before we learned its path.  Ask
+    // for its status without blocking; a Completed signal that arrives
+    // in the meantime takes precedence.
+    const auto status = co_await queryStatus(objectPath,
+        QStringLiteral("Failed to connect to operation object"));
+    if (!waiter.result && status) {
+        waiter.result = *status;
+    }
+
+    const OperationResult result = co_await Awaiter{&waiter};
+    qCDebug(KAPSULE_LOG) << "Operation finished: success=" << result.success << "error=" << result.error;
+    co_return result;
+}
+
+QCoro::Task<bool> OperationWatcher::cancel(QString objectPath)
+{
+    qCDebug(KAPSULE_LOG) << "Cancelling operation at" << objectPath;
+    co_return co_await callOperation(std::move(objectPath), QStringLiteral("Cancel"));
+}
+
+QCoro::Task<bool> OperationWatcher::subscribe(QString objectPath)
+{
+    qCDebug(KAPSULE_LOG) << "Subscribing to operation at" << objectPath;
+    co_return co_await callOperation(std::move(objectPath), QStringLiteral("Subscribe"));
+}
+
+bool OperationWatcher::hasWaiters() const
+{
+    return !m_waiters.isEmpty();
+}
+
+QCoro::Task<> OperationWatcher::reattach(QStringList running)
+{
+    const QStringList paths = m_waiters.uniqueKeys();
+    for (const QString &path : paths) {
+        // Resumed operations keep their requester, but subscribing also
+        // covers waits started with watchOperation(), whose subscription
+        // was lost.  If it finished in the meantime, its status says how.
+        if (running.contains(path) && co_await subscribe(path)) {
+            qCDebug(KAPSULE_LOG) << "Reattached to resumed operation" << path;
+            continue;
+        }
+
+        const auto status = co_await queryStatus(path,
+            QStringLiteral("The operation was interrupted by a restart of kapsule-daemon"));
+        if (status) {
+            finish(path, *status);
+        }
+    }
+}
+
+void OperationWatcher::failAll(const QString &error)
+{
+    const QStringList paths = m_waiters.uniqueKeys();
+    for (const QString &path : paths) {
+        finish(path, OperationResult{false, error});
+    }
+}
+
+QCoro::Task<std::optional<OperationResult>> OperationWatcher::queryStatus(QString objectPath,
+                                                                         QString goneError)
+{
+    auto call = QDBusMessage::createMethodCall(kService, objectPath,
+        QStringLiteral("org.freedesktop.DBus.Properties"), QStringLiteral("GetAll"));
+    call << kOperationInterface;
+    QDBusPendingReply<QVariantMap> pending = m_bus.asyncCall(call);
+    const auto reply = co_await pending;
+
+    if (reply.isError()) {
+        qCWarning(KAPSULE_LOG) << "Operation status query failed:" << reply.error().message();
+        co_return OperationResult{false, goneError};
+    }
+
+    const QVariantMap properties = reply.value();
+    const QString status = properties.value(QStringLiteral("Status")).toString();
+    qCDebug(KAPSULE_LOG) << "Current operation status:" << status;
+    if (status == QLatin1String("running")) {
+        co_return std::nullopt;
+    }
+    co_return OperationResult{
+        status == QLatin1String("completed"),
+        properties.value(QStringLiteral("ErrorMessage")).toString(),
+    };
+}
+
+QCoro::Task<bool> OperationWatcher::callOperation(QString objectPath, QString method)
+{
+    auto call = QDBusMessage::createMethodCall(kService, objectPath, kOperationInterface, method);
+    QDBusPendingReply<bool> pending = m_bus.asyncCall(call);
+    const auto reply = co_await pending;
+
+    if (reply.isError()) {
+        // The object is gone once the operation has finished
+        qCDebug(KAPSULE_LOG) << method << "failed:" << reply.error().message();
+        co_return false;
+    }
+    co_return reply.value();
+}
+
+void OperationWatcher::finish(const QString &objectPath, const OperationResult &result)
+{
+    // Resuming a waiter lets it unregister itself, so work on a copy.
+    const QList<Waiter *> waiters = m_waiters.values(objectPath);
+    for (Waiter *waiter : waiters) {
+        if (waiter->result) {
+            continue;
+        }
+        waiter->result = result;
+        if (auto handle = std::exchange(waiter->continuation, {})) {
+            handle.resume();
+        }
+    }
+}
+
+void OperationWatcher::handleSignal(const QDBusMessage &message)
+{
+    const QString path = message.path();
+    if (!m_waiters.contains(path)) {
+        return;
+    }
+
+    const QString member = message.member();
+    const QVariantList args = message.arguments();
+
+    if (member == QLatin1String("Completed") && args.size() >= 2) {
+        finish(path, OperationResult{args.at(0).toBool(), args.at(1).toString()});
+        return;
+    }
+
+    const QList<Waiter *> waiters = m_waiters.values(path);
+    for (const Waiter *waiter : waiters) {
+        const OperationCallbacks &cb = waiter->callbacks;
+        if (member == QLatin1String("Message") && args.size() >= 3) {
+            if (cb.onMessage) {
+                cb.onMessage(static_cast<MessageType>(args.at(0).toInt()),
+                             args.at(1).toString(), args.at(2).toInt());
+            }
+        } else if (member == QLatin1String("ProgressStarted") && args.size() >= 4) {
+            if (cb.onProgressStart) {
+                cb.onProgressStart(args.at(0).toString(), args.at(1).toString(),
+                                   args.at(2).toInt(), args.at(3).toInt());
+            }
+        } else if (member == QLatin1String("ProgressUpdate") && args.size() >= 3) {
+            if (cb.onProgressUpdate) {
+                cb.onProgressUpdate(args.at(0).toString(), args.at(1).toInt(),
+                                    args.at(2).toDouble());
+            }
+        } else if (member == QLatin1String("ProgressTextUpdate") && args.size() >= 2) {
+            if (cb.onProgressTextUpdate) {
+                cb.onProgressTextUpdate(args.at(0).toString(), args.at(1).toString());
+            }
+        } else if (member == QLatin1String("ProgressCompleted") && args.size() >= 3) {
+            if (cb.onProgressComplete) {
+                cb.onProgressComplete(args.at(0).toString(), args.at(1).toBool(),
+                                      args.at(2).toString());
+            }
+        }
+    }
+}
+
+} // namespace Kapsule
@@ -0,0 +1,109 @@
+/*
+    SPDX-FileCopyrightText: 2024-2026 KDE Community
+    SPDX-License-Identifier: LGPL-2.1-or-later
+*/
+
+#ifndef KAPSULE_OPERATIONWATCHER_H
+#define KAPSULE_OPERATIONWATCHER_H
+
+#include <QDBusConnection>
+#include <QMultiHash>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+
+#include <qcoro/qcorotask.h>
+
+#include <optional>
+
+#include "types.h"
+
+class QDBusMessage;
+
+namespace Kapsule {
+
+/**
+ * @class OperationWatcher
+ * @brief Waits for daemon operations using one shared signal subscription.
+ *
+ * Instead of creating a proxy object (with its own introspection and
+ * match rules) for every operation, the watcher subscribes once to all
+ * org.kde.kapsule.Operation signals from the daemon and dispatches them
+ * to the waiting coroutines by object path.
+ *
+ * The daemon only sends an operation's signals to the client that
+ * started it, so operations started elsewhere need subscribe() first.
+ *
+ * @internal
+ */
+class OperationWatcher : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit OperationWatcher(const QDBusConnection &bus, QObject *parent = nullptr);
+    ~OperationWatcher() override;
+
+    /**
+     * @brief Wait for the operation at @p objectPath to finish.
+     *
+     * Must be called without suspending after the method call that
+     * returned @p objectPath, so that no signal is dispatched before the
+     * waiter is registered.  Operations that already finished are
+     * detected with an asynchronous status query.
+     */
+    QCoro::Task<OperationResult> watch(QString objectPath, OperationCallbacks callbacks);
+
+    /**
+     * @brief Ask the daemon to cancel the operation at @p objectPath.
+     * @return true if the operation was running and is now being cancelled.
+     */
+    QCoro::Task<bool> cancel(QString objectPath);
+
+    /**
+     * @brief Ask the daemon to send the signals of an operation that
+     *        another client started to this connection as well.
+     * @return true if subscribed, false if the operation already finished.
+     */
+    QCoro::Task<bool> subscribe(QString objectPath);
+
+    /**
+     * @brief Returns whether any coroutine is waiting for an operation.
+     */
+    [[nodiscard]] bool hasWaiters() const;
+
+    /**
+     * @brief Settle every pending wait after the daemon restarted.
+     *
+     * Operations in @p running, which the new daemon resumed under their
+     * old paths, are subscribed to again and keep being waited for.  The
+     * others finished before the restart or died with the old daemon, and
+     * are resolved from their status or failed.
+     *
+     * @param running Object paths returned by ListOperations.
+     */
+    QCoro::Task<> reattach(QStringList running);
+
+    /**
+     * @brief Fail every pending wait with @p error.
+     */
+    void failAll(const QString &error);
+
+private Q_SLOTS:
+    void handleSignal(const QDBusMessage &message);
+
+private:
+    struct Waiter;
+    struct Awaiter;
+
+    void finish(const QString &objectPath, const OperationResult &result);
+    QCoro::Task<bool> callOperation(QString objectPath, QString method);
+    QCoro::Task<std::optional<OperationResult>> queryStatus(QString objectPath, QString goneError);
+
+    QDBusConnection m_bus;
+    QMultiHash<QString, Waiter *> m_waiters;
+};
+
+} // namespace Kapsule
+
+#endif // KAPSULE_OPERATIONWATCHER_H
@@ -5,11 +5,18 @@
 
 #include "types.h"
 #include "container.h"
+#include "containerstats.h"
+#include "image.h"
+#include "kapsuledbustypes.h"
 #include <QDBusMetaType>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonArray>
 
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
 namespace Kapsule {
 
 // =============================================================================
@@ -44,16 +51,116 @@ QList<CreateSchemaOption> CreateSchema::allOptions() const
 
 std::optional<CreateSchemaOption> CreateSchema::option(const QString &key) const
 {
-    for (const auto &section : sections) {
-        for (const auto &opt : section.options) {
-            if (opt.key == key) {
-                return opt;
-            }
-        }
+    if (const CreateSchemaOption *opt = find(key)) {
+        return *opt;
     }
     return std::nullopt;
 }
 
+const CreateSchemaOption *CreateSchema::find(const QString &key) const
+{
+    for (const auto &opt : options()) {
+        if (opt.key == key) {
+            return &opt;
+        }
+    }
+    return nullptr;
+}
+
+const CreateSchemaOption *CreateSchema::findByFlag(const QString &flag) const
+{
+    for (const auto &opt : options()) {
+        if (opt.cliFlag() == flag) {
+            return &opt;
+        }
+    }
+    return nullptr;
+}
+
+// =============================================================================
+// CreateSchemaIndex
+// =============================================================================
+
+CreateSchemaIndex::CreateSchemaIndex(const CreateSchema &schema)
+    : m_schema(schema)
+{
+    const auto &sections = m_schema.sections;
+    for (qsizetype s = 0; s < sections.size(); ++s) {
+        const auto &options = sections.at(s).options;
+        for (qsizetype o = 0; o < options.size(); ++o) {
+            m_byKey.insert(options.at(o).key, {s, o});
+            m_byFlag.insert(options.at(o).cliFlag(), {s, o});
+        }
+    }
+}
+
+const CreateSchema &CreateSchemaIndex::schema() const
+{
+    return m_schema;
+}
+
+const CreateSchemaOption *CreateSchemaIndex::find(const QString &key) const
+{
+    return at(m_byKey, key);
+}
+
+const CreateSchemaOption *CreateSchemaIndex::findByFlag(const QString &flag) const
+{
+    return at(m_byFlag, flag);
+}
+
+const CreateSchemaOption *CreateSchemaIndex::at(const QHash<QString, Position> &index,
+                                                const QString &name) const
+{
+    const auto it = index.constFind(name);
+    if (it == index.constEnd()) {
+        return nullptr;
+    }
+    const auto [s, o] = *it;
+    return &m_schema.sections.at(s).options.at(o);
+}
+
+// =============================================================================
+// LatencyHistogram
+// =============================================================================
+
+void LatencyHistogram::record(std::chrono::microseconds sample)
+{
+    if (count == 0 || sample < min) {
+        min = sample;
+    }
+    max = std::max(max, sample);
+    total += sample;
+    ++count;
+
+    // Bucket i holds samples under 2^i ms, i.e. bit_width(ms) == i.
+    const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(sample).count();
+    const int bucket = ms <= 0 ? 0 : std::bit_width(static_cast<quint64>(ms));
+    ++buckets[std::min(bucket, BucketCount - 1)];
+}
+
+std::chrono::microseconds LatencyHistogram::mean() const
+{
+    return count == 0 ? std::chrono::microseconds{0} : total / static_cast<qint64>(count);
+}
+
+std::chrono::microseconds LatencyHistogram::quantile(double fraction) const
+{
+    if (count == 0) {
+        return std::chrono::microseconds{0};
+    }
+
+    const auto rank = std::max<quint64>(1, static_cast<quint64>(std::ceil(fraction * count)));
+    quint64 seen = 0;
+    for (int i = 0; i < BucketCount - 1; ++i) {
+        seen += buckets[i];
+        if (seen >= rank) {
+            return std::min(max, std::chrono::microseconds(std::chrono::milliseconds(1LL << i)));
+        }
+    }
+    return max;
+}
+
 // =============================================================================
 // Schema parser
 // =============================================================================
@@ -126,16 +233,22 @@ const QDBusArgument &operator>>(const QDBusArgument &arg, EnterResult &result)
 
 void registerDBusTypes()
 {
-    static bool registered = false;
-    if (registered) {
-        return;
-    }
-    registered = true;
-
-    qDBusRegisterMetaType<Container>();
-    qDBusRegisterMetaType<QList<Container>>();
-    qDBusRegisterMetaType<EnterResult>();
-    qDBusRegisterMetaType<QMap<QString, QString>>();
+    // Clients may be created on several threads at once; a function-local
+    // static is initialized exactly once, and the others wait for it.
+    static const bool registered = [] {
+        qDBusRegisterMetaType<Container>();
+        qDBusRegisterMetaType<QList<Container>>();
+        qDBusRegisterMetaType<ContainerV2>();
+        qDBusRegisterMetaType<QList<ContainerV2>>();
+        qDBusRegisterMetaType<ContainerStats>();
+        qDBusRegisterMetaType<QList<ContainerStats>>();
+        qDBusRegisterMetaType<Image>();
+        qDBusRegisterMetaType<QList<Image>>();
+        qDBusRegisterMetaType<EnterResult>();
+        qDBusRegisterMetaType<QMap<QString, QString>>();
+        return true;
+    }();
+    Q_UNUSED(registered);
 }
 
 } // namespace Kapsule
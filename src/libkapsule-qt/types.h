@@ -6,14 +6,20 @@
 #ifndef KAPSULE_TYPES_H
 #define KAPSULE_TYPES_H
 
+#include <QHash>
+#include <QMap>
 #include <QString>
 #include <QStringList>
 #include <QMetaType>
 #include <QMetaEnum>
 #include <QVariantMap>
 #include <QJsonValue>
+#include <array>
+#include <chrono>
 #include <functional>
 #include <optional>
+#include <ranges>
+#include <utility>
 
 #include "kapsule_export.h"
 
@@ -67,16 +73,69 @@ struct KAPSULE_EXPORT CreateSchemaSection {
 
 /**
  * @brief The full create-container schema.
+ *
+ * A plain aggregate: the lookups below scan the options.  Use
+ * CreateSchemaIndex for repeated lookups.
  */
 struct KAPSULE_EXPORT CreateSchema {
     int version = 0;
     QList<CreateSchemaSection> sections;
 
+    /// Every option across all sections in display order, without copying.
+    [[nodiscard]] auto options() const
+    {
+        return sections
+            | std::views::transform([](const CreateSchemaSection &s) -> const QList<CreateSchemaOption> & {
+                  return s.options;
+              })
+            | std::views::join;
+    }
+
     /// Flat list of every option across all sections.
     [[nodiscard]] QList<CreateSchemaOption> allOptions() const;
 
     /// Look up an option by key.
     [[nodiscard]] std::optional<CreateSchemaOption> option(const QString &key) const;
+
+    /// Look up an option by key without copying it; nullptr if unknown.
+    [[nodiscard]] const CreateSchemaOption *find(const QString &key) const;
+
+    /// Look up an option by CLI flag (e.g. "mount-home"); nullptr if unknown.
+    [[nodiscard]] const CreateSchemaOption *findByFlag(const QString &flag) const;
+};
+
+/**
+ * @brief Hash lookup of a CreateSchema's options by key and by CLI flag.
+ *
+ * The index keeps its own copy of the schema, which is implicitly shared
+ * and never modified, so its entries can't go stale when the schema it
+ * was built from changes.
+ */
+class KAPSULE_EXPORT CreateSchemaIndex
+{
+public:
+    CreateSchemaIndex() = default;
+    explicit CreateSchemaIndex(const CreateSchema &schema);
+
+    /// The indexed schema.
+    [[nodiscard]] const CreateSchema &schema() const;
+
+    /// Look up an option by key without copying it; nullptr if unknown.
+    [[nodiscard]] const CreateSchemaOption *find(const QString &key) const;
+
+    /// Look up an option by CLI flag (e.g. "mount-home"); nullptr if unknown.
+    [[nodiscard]] const CreateSchemaOption *findByFlag(const QString &flag) const;
+
+private:
+    // (section, option) positions, so copies of the index stay valid.
+    using Position = std::pair<qsizetype, qsizetype>;
+
+    [[nodiscard]] const CreateSchemaOption *at(const QHash<QString, Position> &index,
+                                               const QString &name) const;
+
+    CreateSchema m_schema;
+    QHash<QString, Position> m_byKey;
+    QHash<QString, Position> m_byFlag;
 };
 
 /**
@@ -152,6 +211,53 @@ struct OperationCallbacks {
 
     /// Called when a progress bar completes
     std::function<void(const QString &progressId, bool success, const QString &message)> onProgressComplete;
+
+    /// Called once the daemon has accepted the operation, before any other
+    /// callback.  Keep the path to cancel it with KapsuleClient::cancelOperation().
+    std::function<void(const QString &objectPath)> onStarted;
+};
+
+/**
+ * @brief Latency distribution of one kind of client call.
+ *
+ * Samples are counted in power-of-two millisecond buckets: bucket 0 holds
+ * samples under 1 ms, bucket i samples under 2^i ms, and the last bucket
+ * everything slower.
+ */
+struct KAPSULE_EXPORT LatencyHistogram {
+    static constexpr int BucketCount = 16;
+
+    quint64 count = 0;
+    std::chrono::microseconds total{0};
+    std::chrono::microseconds min{0};
+    std::chrono::microseconds max{0};
+    std::array<quint64, BucketCount> buckets{};
+
+    /// Add one sample.
+    void record(std::chrono::microseconds sample);
+
+    /// Average of all samples, or zero if there are none.
+    [[nodiscard]] std::chrono::microseconds mean() const;
+
+    /// Upper bound of the bucket holding the @p fraction quantile
+    /// (0.5 for the median), capped at the slowest sample.
+    [[nodiscard]] std::chrono::microseconds quantile(double fraction) const;
+};
+
+/**
+ * @brief Latencies recorded by KapsuleClient while statistics are enabled.
+ *
+ * All maps are keyed by the daemon's D-Bus method name.
+ */
+struct KAPSULE_EXPORT ClientStatistics {
+    /// Round trip of each method call, from sending it to its reply
+    QMap<QString, LatencyHistogram> calls;
+
+    /// For operations, from the method reply to the first progress signal
+    QMap<QString, LatencyHistogram> operationFirstSignal;
+
+    /// For operations, from the method reply until the operation finished
+    QMap<QString, LatencyHistogram> operationTotal;
 };
 
 /**
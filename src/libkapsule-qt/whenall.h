@@ -0,0 +1,114 @@
+/*
+    SPDX-FileCopyrightText: 2024-2026 KDE Community
+    SPDX-License-Identifier: LGPL-2.1-or-later
+*/
+
+#ifndef KAPSULE_WHENALL_H
+#define KAPSULE_WHENALL_H
+
+#include <QList>
+
+#include <exception>
+#include <optional>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <qcoro/qcorotask.h>
+
+namespace Kapsule {
+
+namespace detail {
+
+// Awaits @p task, recording its exception (if it is the first one) in
+// @p error instead of letting it escape, so whenAll() can wait for the
+// remaining tasks before reporting it.
+template<typename T>
+QCoro::Task<std::optional<T>> settle(QCoro::Task<T> task, std::exception_ptr &error)
+{
+    try {
+        co_return co_await std::move(task);
+    } catch (...) {
+        if (!error) {
+            error = std::current_exception();
+        }
+        co_return std::nullopt;
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief Awaits several independent tasks together.
+ *
+ * QCoro tasks start running as soon as they are created, so every
+ * KapsuleClient call passed in is already on the bus by the time
+ * whenAll() is entered; awaiting the result takes as long as the slowest
+ * call instead of the sum of all of them.
+ *
+ * @code
+ * auto [config, containers, images] = co_await whenAll(
+ *     client.config(), client.listContainers(), client.listImages());
+ * @endcode
+ *
+ * KapsuleClient methods report failures in their return values and don't
+ * throw. If any task does throw, whenAll() still waits for every task to
+ * finish and then rethrows the first exception, so no call is left
+ * running with nobody to observe it.
+ *
+ * @return The tasks' results, in the order the tasks were given.
+ */
+template<typename... Ts>
+QCoro::Task<std::tuple<Ts...>> whenAll(QCoro::Task<Ts>... tasks)
+{
+    std::exception_ptr error;
+    // Elements of a braced initializer are evaluated left to right.
+    std::tuple<std::optional<Ts>...> results{co_await detail::settle(std::move(tasks), error)...};
+    if (error) {
+        std::rethrow_exception(error);
+    }
+    co_return std::apply(
+        [](auto &...result) {
+            return std::tuple<Ts...>{std::move(*result)...};
+        },
+        results);
+}
+
+/**
+ * @brief Awaits a variable number of tasks of the same type together.
+ *
+ * Useful for fanning one call out over several containers:
+ *
+ * @code
+ * std::vector<QCoro::Task<Container>> tasks;
+ * for (const QString &name : names) {
+ *     tasks.push_back(client.container(name));
+ * }
+ * const QList<Container> containers = co_await whenAll(std::move(tasks));
+ * @endcode
+ *
+ * Error handling is the same as for the variadic overload.
+ *
+ * @return The tasks' results, in the order the tasks were given.
+ */
+template<typename T>
+QCoro::Task<QList<T>> whenAll(std::vector<QCoro::Task<T>> tasks)
+{
+    std::exception_ptr error;
+    QList<T> results;
+    results.reserve(static_cast<qsizetype>(tasks.size()));
+    for (auto &task : tasks) {
+        auto result = co_await detail::settle(std::move(task), error);
+        if (result) {
+            results.append(std::move(*result));
+        }
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+    co_return results;
+}
+
+} // namespace Kapsule
+
+#endif // KAPSULE_WHENALL_H
@@ -0,0 +1,81 @@
+#!/bin/bash
+
+# SPDX-FileCopyrightText: 2026 Lasath Fernando <devel@lasath.org>
+#
+# SPDX-License-Identifier: GPL-3.0-or-later
+
+# Test: Bulk lifecycle operations (StartContainers, StopContainers,
+# DeleteContainers)
+#
+# Tests that kapsule start/stop/rm act on several containers in one
+# operation, and that one failing container doesn't stop the others.
+
+source "$(dirname "${BASH_SOURCE[0]}")/helpers.sh"
+
+CONTAINER_A="test-bulk-a"
+CONTAINER_B="test-bulk-b"
+MISSING="test-bulk-missing"
+
+# ============================================================================
+# Setup
+# ============================================================================
+
+cleanup_container "$CONTAINER_A"
+cleanup_container "$CONTAINER_B"
+
+# ============================================================================
+# Tests
+# ============================================================================
+
+echo "Testing bulk lifecycle operations..."
+
+echo ""
+echo "1. Create containers"
+create_container "$CONTAINER_A" "images:alpine/edge" >/dev/null 2>&1
+create_container "$CONTAINER_B" "images:alpine/edge" >/dev/null 2>&1
+assert_container_state "$CONTAINER_A" "RUNNING"
+assert_container_state "$CONTAINER_B" "RUNNING"
+
+echo ""
+echo "2. Stop both containers"
+stop_output=$(ssh_vm "kapsule stop '$CONTAINER_A' '$CONTAINER_B'" 2>&1) || {
+    echo "kapsule stop failed"
+    echo "$stop_output"
+    exit 1
+}
+assert_contains "Both containers reported" "$stop_output" "$CONTAINER_B: stopped"
+wait_for_state "$CONTAINER_A" "STOPPED" 30
+wait_for_state "$CONTAINER_B" "STOPPED" 30
+assert_container_state "$CONTAINER_A" "STOPPED"
+assert_container_state "$CONTAINER_B" "STOPPED"
+
+echo ""
+echo "3. One missing container fails the operation but not the others"
+assert_failure "Start with a missing container fails" \
+    ssh_vm "kapsule start '$CONTAINER_A' '$MISSING' '$CONTAINER_B'" >/dev/null 2>&1
+wait_for_state "$CONTAINER_A" "RUNNING" 30
+wait_for_state "$CONTAINER_B" "RUNNING" 30
+assert_container_state "$CONTAINER_A" "RUNNING"
+assert_container_state "$CONTAINER_B" "RUNNING"
+
+echo ""
+echo "4. Names and --all cannot be combined"
+assert_failure "stop NAME --all is rejected" \
+    ssh_vm "kapsule stop '$CONTAINER_A' --all" >/dev/null 2>&1
+
+echo ""
+echo "5. Force-remove both containers"
+assert_success "rm --force removes both" \
+    ssh_vm "kapsule rm --force '$CONTAINER_A' '$CONTAINER_B'" >/dev/null 2>&1
+assert_container_not_exists "$CONTAINER_A"
+assert_container_not_exists "$CONTAINER_B"
+
+# ============================================================================
+# Cleanup
+# ============================================================================
+
+cleanup_container "$CONTAINER_A"
+cleanup_container "$CONTAINER_B"
+
+echo ""
+echo "Bulk lifecycle tests passed!"
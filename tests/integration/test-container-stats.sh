@@ -0,0 +1,67 @@
+#!/bin/bash
+
+# SPDX-FileCopyrightText: 2026 Lasath Fernando <devel@lasath.org>
+#
+# SPDX-License-Identifier: GPL-3.0-or-later
+
+# Test: Container resource usage (GetContainerStats and kapsule top)
+#
+# Tests that running containers report resource usage and stopped ones
+# are left out.
+
+source "$(dirname "${BASH_SOURCE[0]}")/helpers.sh"
+
+CONTAINER_NAME="test-stats"
+
+# ============================================================================
+# Setup
+# ============================================================================
+
+cleanup_container "$CONTAINER_NAME"
+
+# ============================================================================
+# Tests
+# ============================================================================
+
+echo "Testing container stats..."
+
+echo ""
+echo "1. Create container"
+create_container "$CONTAINER_NAME" "images:alpine/edge" >/dev/null 2>&1
+assert_container_exists "$CONTAINER_NAME"
+assert_container_state "$CONTAINER_NAME" "RUNNING"
+
+echo ""
+echo "2. Stats via D-Bus"
+dbus_output=$(dbus_call "GetContainerStats" "as" 1 "'$CONTAINER_NAME'" 2>&1) || {
+    echo "D-Bus GetContainerStats failed"
+    echo "$dbus_output"
+    exit 1
+}
+assert_contains "D-Bus reports the running container" "$dbus_output" "$CONTAINER_NAME"
+
+echo ""
+echo "3. kapsule top --once"
+top_output=$(ssh_vm "kapsule top --once --interval 1" 2>&1) || {
+    echo "kapsule top failed"
+    echo "$top_output"
+    exit 1
+}
+assert_contains "top shows header" "$top_output" "MEM"
+assert_contains "top shows the container" "$top_output" "$CONTAINER_NAME"
+
+echo ""
+echo "4. Stopped containers are left out"
+ssh_vm "kapsule stop '$CONTAINER_NAME'" >/dev/null 2>&1
+wait_for_state "$CONTAINER_NAME" "STOPPED" 30
+dbus_output=$(dbus_call "GetContainerStats" "as" 1 "'$CONTAINER_NAME'" 2>&1)
+assert_eq "Stopped container has no stats" "a(sxxxxxxxi) 0" "$dbus_output"
+
+# ============================================================================
+# Cleanup
+# ============================================================================
+
+cleanup_container "$CONTAINER_NAME"
+
+echo ""
+echo "Container stats tests passed!"
@@ -0,0 +1,137 @@
+#!/bin/bash
+
+# SPDX-FileCopyrightText: 2026 Lasath Fernando <devel@lasath.org>
+#
+# SPDX-License-Identifier: GPL-3.0-or-later
+
+# Test: Daemon restarts
+#
+# Tests that operation ids keep counting across a daemon restart, that
+# a client waiting on an operation when the daemon restarts gets an
+# answer instead of waiting forever, and that a resumable operation
+# interrupted by the restart is resumed and seen through by its client.
+
+source "$(dirname "${BASH_SOURCE[0]}")/helpers.sh"
+
+CONTAINER_NAME="test-daemon-restart"
+MISSING="test-daemon-restart-missing"
+IMPORT_ALIAS="test-daemon-restart-import"
+IMPORT_DIR="/var/tmp/kapsule-test-daemon-restart"
+IMPORT_SOURCE="kapsule:archlinux"
+
+# Restarting the service needs root, like deploying it does
+restart_daemon() {
+    ssh $SSH_OPTS "root@${TEST_VM#*@}" "systemctl restart kapsule-daemon.service"
+    local retries=10
+    while ((retries > 0)); do
+        if ssh_vm "busctl status org.kde.kapsule" &>/dev/null; then
+            return 0
+        fi
+        sleep 1
+        ((retries--))
+    done
+    echo "Daemon did not come back after restart"
+    return 1
+}
+
+# Print the numeric id of an operation path returned by busctl
+operation_id() {
+    sed -n 's|.*/org/kde/kapsule/operations/\([0-9]*\).*|\1|p' <<<"$1"
+}
+
+# ============================================================================
+# Setup
+# ============================================================================
+
+cleanup_container "$CONTAINER_NAME"
+ssh_vm "incus image delete '$IMPORT_ALIAS'" &>/dev/null || true
+
+# A split image with a fingerprint Incus hasn't seen, large enough that
+# importing it is still running when the daemon restarts.
+ssh_vm "set -e
+    rm -rf '$IMPORT_DIR' && mkdir -p '$IMPORT_DIR/export' '$IMPORT_DIR/meta'
+    incus image export '$IMPORT_SOURCE' '$IMPORT_DIR/export/' >/dev/null
+    tar -xJf '$IMPORT_DIR'/export/*.tar.xz -C '$IMPORT_DIR/meta'
+    date +%s%N > '$IMPORT_DIR/meta/kapsule-test-daemon-restart'
+    tar -cJf '$IMPORT_DIR/incus.tar.xz' -C '$IMPORT_DIR/meta' .
+    mv '$IMPORT_DIR'/export/*.squashfs '$IMPORT_DIR/rootfs.squashfs'
+    rm -rf '$IMPORT_DIR/export' '$IMPORT_DIR/meta'"
+
+# ============================================================================
+# Tests
+# ============================================================================
+
+echo "Testing daemon restarts..."
+
+echo ""
+echo "1. Operation ids keep counting across a restart"
+# Stopping a missing container starts (and fails) an operation, which
+# is enough to allocate an id.
+first=$(dbus_call "StopContainer" "sb" "'$MISSING'" false 2>&1)
+first_id=$(operation_id "$first")
+restart_daemon
+second=$(dbus_call "StopContainer" "sb" "'$MISSING'" false 2>&1)
+second_id=$(operation_id "$second")
+if [[ -z "$first_id" || -z "$second_id" ]]; then
+    echo "Unexpected StopContainer replies: $first / $second"
+    exit 1
+fi
+assert_success "Id after restart ($second_id) is above id before ($first_id)" \
+    test "$second_id" -gt "$first_id"
+
+echo ""
+echo "2. A waiting client is answered when the daemon restarts"
+# kapsule create exits with 124 from timeout if it never hears back.
+ssh_vm "timeout 120 kapsule create '$CONTAINER_NAME' --image images:alpine/edge" \
+    >/dev/null 2>&1 &
+create_pid=$!
+sleep 2
+restart_daemon
+status=0
+wait "$create_pid" || status=$?
+if [[ "$status" -eq 124 ]]; then
+    echo -e "  ${RED}✗${NC} kapsule create hung after the daemon restarted"
+    exit 1
+fi
+echo -e "  ${GREEN}✓${NC} kapsule create returned (exit status $status)"
+
+echo ""
+echo "3. A resumable operation is resumed and its client sees it complete"
+import_log=$(mktemp)
+ssh_vm "timeout 600 kapsule image import '$IMPORT_DIR' '$IMPORT_ALIAS'" \
+    >"$import_log" 2>&1 &
+import_pid=$!
+# Restart only once the import is under way, so it is journaled
+retries=60
+until grep -q "Uploading image" "$import_log"; do
+    if ((retries-- == 0)) || ! kill -0 "$import_pid" 2>/dev/null; then
+        echo "kapsule image import never started uploading"
+        cat "$import_log"
+        exit 1
+    fi
+    sleep 1
+done
+restart_daemon
+status=0
+wait "$import_pid" || status=$?
+import_output=$(cat "$import_log")
+rm -f "$import_log"
+if [[ "$status" -ne 0 ]]; then
+    echo -e "  ${RED}✗${NC} kapsule image import failed (exit status $status)"
+    echo "$import_output"
+    exit 1
+fi
+assert_contains "Import was resumed" "$import_output" "Resuming after a daemon restart"
+assert_contains "Client saw the import complete" "$import_output" "Image imported successfully"
+assert_success "Imported image has its alias" \
+    ssh_vm "incus image show '$IMPORT_ALIAS'" >/dev/null 2>&1
+
+# ============================================================================
+# Cleanup
+# ============================================================================
+
+cleanup_container "$CONTAINER_NAME"
+ssh_vm "incus image delete '$IMPORT_ALIAS'; rm -rf '$IMPORT_DIR'" &>/dev/null || true
+
+echo ""
+echo "Daemon restart tests passed!"
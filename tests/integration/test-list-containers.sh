@@ -59,6 +59,77 @@ dbus_output=$(dbus_call "ListContainers" 2>&1) || {
 assert_contains "D-Bus shows container 1" "$dbus_output" "$CONTAINER_1"
 assert_contains "D-Bus shows container 2" "$dbus_output" "$CONTAINER_2"
 
+# Test: Server-side filtering
+echo ""
+echo "5. Filter by state and name"
+ssh_vm "kapsule stop '$CONTAINER_2'" >/dev/null 2>&1
+wait_for_state "$CONTAINER_2" "STOPPED" 30
+
+dbus_output=$(dbus_call "QueryContainers" "a{sv}as" 2 \
+    states as 1 Running name s "'test-list-*'" 1 status 2>&1) || {
+    echo "D-Bus QueryContainers failed"
+    echo "$dbus_output"
+    exit 1
+}
+assert_eq "Only the running container matches" \
+    "a(sssss) 1 \"$CONTAINER_1\" \"Running\" \"\" \"\" \"\"" "$dbus_output"
+
+running_output=$(ssh_vm "kapsule list --running" 2>&1)
+assert_contains "list --running shows container 1" "$running_output" "$CONTAINER_1"
+if [[ "$running_output" == *"$CONTAINER_2"* ]]; then
+    echo "list --running shows a stopped container"
+    exit 1
+fi
+
+name_output=$(ssh_vm "kapsule list --name '*-2'" 2>&1)
+assert_contains "list --name matches container 2" "$name_output" "$CONTAINER_2"
+
+# Test: Compact v2 list
+echo ""
+echo "6. List via D-Bus in the v2 format"
+dbus_output=$(dbus_call "ListContainersV2" 2>&1) || {
+    echo "D-Bus ListContainersV2 failed"
+    echo "$dbus_output"
+    exit 1
+}
+assert_contains "v2 shows container 1" "$dbus_output" "\"$CONTAINER_1\" 3 "
+assert_contains "v2 shows container 2" "$dbus_output" "\"$CONTAINER_2\" 1 "
+assert_contains "v2 reports the start time" "$dbus_output" "\"started_at\" x"
+assert_contains "v2 reports the init PID" "$dbus_output" "\"pid\" x"
+
+# Test: Machine-readable output
+echo ""
+echo "7. List with --output json and ndjson"
+json_output=$(ssh_vm "kapsule --output json list --name 'test-list-*'" 2>/dev/null)
+assert_contains "json list is an array" "${json_output:0:1}" "["
+assert_contains "json list has container 1" "$json_output" "\"name\":\"$CONTAINER_1\""
+assert_contains "json list has the state" "$json_output" "\"state\":\"Running\""
+
+ndjson_output=$(ssh_vm "kapsule --output ndjson list --name 'test-list-*'" 2>/dev/null)
+assert_eq "ndjson list has one line per container" "2" "$(wc -l <<<"$ndjson_output")"
+
+events=$(ssh_vm "kapsule --output ndjson start '$CONTAINER_2'" 2>/dev/null)
+assert_contains "ndjson operation reports when it started" "$events" "\"event\":\"started\""
+assert_contains "ndjson operation ends with its result" "$(tail -n 1 <<<"$events")" \
+    "\"event\":\"completed\""
+assert_contains "ndjson events carry timestamps" "$events" "\"time\":\""
+
+usage_error=$(ssh_vm "kapsule --output json list --bogus" 2>/dev/null) || true
+assert_contains "json usage errors are reported as JSON" "$usage_error" "\"success\":false"
+
+# Test: Live list
+echo ""
+echo "8. list --watch redraws on changes"
+ssh_vm "timeout 20 kapsule list --watch --name '$CONTAINER_2' >/tmp/kapsule-watch.out 2>&1" &
+watch_pid=$!
+sleep 3
+ssh_vm "kapsule stop '$CONTAINER_2'" >/dev/null 2>&1
+wait_for_state "$CONTAINER_2" "STOPPED" 30
+wait "$watch_pid" || true
+watch_output=$(ssh_vm "cat /tmp/kapsule-watch.out; rm -f /tmp/kapsule-watch.out")
+assert_contains "first frame shows the container running" "$watch_output" "Running"
+assert_contains "a later frame shows it stopped" "$watch_output" "Stopped"
+
 # ============================================================================
 # Cleanup
 # ============================================================================
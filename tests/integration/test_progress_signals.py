@@ -63,6 +63,9 @@ class SignalCollector:
     completed: list[tuple[str, bool, str]] = field(default_factory=list)
     messages: list[tuple[str, int, str, int]] = field(default_factory=list)
 
+    # Manager-level container deltas, in arrival order
+    container_events: list[tuple[str, tuple]] = field(default_factory=list)
+
 
 def make_signal_handler(collector: SignalCollector, operation_path: str | None = None):
     """Build a message handler that dispatches signals into *collector*.
@@ -83,6 +86,15 @@ def make_signal_handler(collector: SignalCollector, operation_path: str | None =
             path, ifaces = msg.body
             collector.interfaces_removed.append((path, ifaces))
 
+        # Container deltas (on the Manager object)
+        if msg.path == DBUS_PATH and msg.member in (
+            "ContainerUpdated",
+            "ContainerRemoved",
+            "ContainersChanged",
+        ):
+            collector.container_events.append((msg.member, tuple(msg.body)))
+            return
+
         # Operation-level signals (filtered by path when given)
         if operation_path is not None and msg.path != operation_path:
             return
@@ -340,6 +352,243 @@ class TestProgressSignals:
         assert success is True
 
 
+# =========================================================================
+# Tests — container deltas
+# =========================================================================
+
+
+class TestContainerSignals:
+    """Tests for the ContainerUpdated / ContainerRemoved deltas."""
+
+    async def test_create_emits_container_updated(
+        self, bus: MessageBus, collector: SignalCollector
+    ):
+        """Creating a container should emit ContainerUpdated with its
+        details, followed by ContainersChanged."""
+
+        await subscribe_kapsule_signals(bus)
+        bus.add_message_handler(make_signal_handler(collector))
+
+        op_path = await call_create_container(bus, CONTAINER_NAME, TEST_IMAGE)
+        success, message = await wait_for_completed(collector, op_path)
+        assert success is True, message
+
+        members = [m for m, _ in collector.container_events]
+        updates = [
+            body for m, body in collector.container_events
+            if m == "ContainerUpdated" and body[0] == CONTAINER_NAME
+        ]
+        assert len(updates) == 1, f"Expected one ContainerUpdated, got {members}"
+        _name, state, _image, created, mode = updates[0]
+        assert state, "ContainerUpdated carried an empty state"
+        assert created, "ContainerUpdated carried an empty creation time"
+        assert mode in ("Default", "Session", "DbusMux")
+
+        idx = members.index("ContainerUpdated")
+        assert "ContainersChanged" in members[idx + 1 :], (
+            "ContainersChanged should follow ContainerUpdated"
+        )
+
+    async def test_delete_emits_container_removed(
+        self, bus: MessageBus, collector: SignalCollector
+    ):
+        """Deleting a container should emit ContainerRemoved(name)."""
+
+        await subscribe_kapsule_signals(bus)
+        bus.add_message_handler(make_signal_handler(collector))
+
+        op_path = await call_create_container(bus, CONTAINER_NAME, TEST_IMAGE)
+        success, message = await wait_for_completed(collector, op_path)
+        assert success is True, message
+
+        op_path = await call_delete_container(bus, CONTAINER_NAME)
+        success, message = await wait_for_completed(collector, op_path)
+        assert success is True, message
+
+        removed = [
+            body for m, body in collector.container_events
+            if m == "ContainerRemoved"
+        ]
+        assert removed == [(CONTAINER_NAME,)]
+
+
+# =========================================================================
+# Tests — batched operations
+# =========================================================================
+
+
+class TestOperationBatch:
+    """Many operations watched through one subscription."""
+
+    BATCH_SIZE = 100
+
+    async def test_batch_of_operations_all_complete(
+        self, bus: MessageBus, collector: SignalCollector
+    ):
+        """Fire 100 operations back to back and watch them all through a
+        single path_namespace match rule.  (libkapsule-qt instead matches
+        on sender and interface; see the client-driven test below.)
+        Every operation must deliver exactly one Completed signal."""
+
+        await bus.call(
+            Message(
+                destination="org.freedesktop.DBus",
+                path="/org/freedesktop/DBus",
+                interface="org.freedesktop.DBus",
+                member="AddMatch",
+                signature="s",
+                body=[
+                    f"type='signal',sender='{DBUS_NAME}',"
+                    f"path_namespace='{DBUS_PATH}/operations'"
+                ],
+            )
+        )
+        bus.add_message_handler(make_signal_handler(collector))
+
+        # Deleting a missing container fails fast without touching any
+        # real container, so the batch only measures operation plumbing.
+        op_paths = await asyncio.gather(
+            *(
+                call_delete_container(bus, f"nonexistent-batch-{i}")
+                for i in range(self.BATCH_SIZE)
+            )
+        )
+        assert len(set(op_paths)) == self.BATCH_SIZE, "Operation paths not unique"
+
+        results = await asyncio.gather(
+            *(wait_for_completed(collector, path, timeout=60) for path in op_paths)
+        )
+        assert all(success is False for success, _ in results)
+
+        completed_paths = [path for path, _, _ in collector.completed]
+        for path in op_paths:
+            assert completed_paths.count(path) == 1, (
+                f"Expected exactly one Completed for {path}"
+            )
+
+    async def test_batch_of_cli_operations_all_complete(self):
+        """Run the same batch through the kapsule CLI, so every operation
+        is watched by libkapsule-qt's OperationWatcher.  Each command must
+        see its operation fail instead of hanging until the timeout."""
+
+        script = (
+            "pids=(); "
+            f"for i in $(seq 1 {self.BATCH_SIZE}); do "
+            "timeout 60 kapsule rm nonexistent-cli-batch-$i >/dev/null 2>&1 & "
+            "pids+=($!); "
+            "done; "
+            "rc=0; "
+            'for pid in "${pids[@]}"; do '
+            'wait "$pid"; status=$?; '
+            '[ "$status" -eq 1 ] || rc=1; '
+            "done; "
+            "exit $rc"
+        )
+        proc = await ssh_run_on_vm("bash", "-c", f"'{script}'")
+        assert await proc.wait() == 0, (
+            "A kapsule rm in the batch did not report its failed operation"
+        )
+
+
+# =========================================================================
+# Tests — signal routing
+# =========================================================================
+
+
+class TestSignalRouting:
+    """Operation signals go to the requester and subscribers only."""
+
+    async def test_other_clients_do_not_receive_signals(
+        self, bus: MessageBus, collector: SignalCollector
+    ):
+        """A client that did not start an operation should not see its
+        Completed signal, even with a match rule for the daemon."""
+
+        observer_bus = await MessageBus(bus_type=BusType.SYSTEM).connect()
+        try:
+            observer = SignalCollector()
+            await subscribe_kapsule_signals(observer_bus)
+            observer_bus.add_message_handler(make_signal_handler(observer))
+
+            await subscribe_kapsule_signals(bus)
+            bus.add_message_handler(make_signal_handler(collector))
+
+            op_path = await call_delete_container(bus, "nonexistent-container-xyz")
+            await wait_for_completed(collector, op_path)
+            await asyncio.sleep(0.5)
+
+            assert not [c for c in observer.completed if c[0] == op_path], (
+                "Non-subscribed client received a unicast operation signal"
+            )
+        finally:
+            observer_bus.disconnect()
+
+    async def test_subscribe_receives_signals(
+        self, bus: MessageBus, collector: SignalCollector
+    ):
+        """A client that calls Subscribe() should receive the operation's
+        signals until it completes."""
+
+        observer_bus = await MessageBus(bus_type=BusType.SYSTEM).connect()
+        try:
+            observer = SignalCollector()
+            await subscribe_kapsule_signals(observer_bus)
+            observer_bus.add_message_handler(make_signal_handler(observer))
+
+            op_path = await call_create_container(bus, CONTAINER_NAME, TEST_IMAGE)
+            reply = await observer_bus.call(
+                Message(
+                    destination=DBUS_NAME,
+                    path=op_path,
+                    interface="org.kde.kapsule.Operation",
+                    member="Subscribe",
+                )
+            )
+            assert reply.message_type == MessageType.METHOD_RETURN
+            if not reply.body[0]:
+                pytest.skip("Create finished before the observer subscribed")
+
+            success, _ = await wait_for_completed(observer, op_path, timeout=120)
+            assert success is True, "Subscriber should see the create succeed"
+        finally:
+            observer_bus.disconnect()
+
+
+# =========================================================================
+# Tests — cancellation
+# =========================================================================
+
+
+class TestCancellation:
+    """Tests for Operation.Cancel."""
+
+    async def test_cancel_create_reports_cancelled(
+        self, bus: MessageBus, collector: SignalCollector
+    ):
+        """Cancelling a running create should finish the operation with
+        success=False and leave its status as "cancelled"."""
+
+        await subscribe_kapsule_signals(bus)
+        bus.add_message_handler(make_signal_handler(collector))
+
+        op_path = await call_create_container(bus, CONTAINER_NAME, TEST_IMAGE)
+        reply = await bus.call(
+            Message(
+                destination=DBUS_NAME,
+                path=op_path,
+                interface="org.kde.kapsule.Operation",
+                member="Cancel",
+            )
+        )
+        assert reply.message_type == MessageType.METHOD_RETURN
+        if not reply.body[0]:
+            pytest.skip("Create finished before it could be cancelled")
+
+        success, message = await wait_for_completed(collector, op_path)
+        assert success is False, "Cancelled create should not succeed"
+        assert "cancelled" in message.lower(), f"Unexpected message: {message}"
+
+
 # =========================================================================
 # Tests — error handling
 # =========================================================================
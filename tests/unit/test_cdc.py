@@ -0,0 +1,75 @@
+# SPDX-FileCopyrightText: 2026 Lasath Fernando <devel@lasath.org>
+#
+# SPDX-License-Identifier: GPL-3.0-or-later
+
+"""Tests for the content-defined chunker shared by the image server and daemon.
+
+Published chunk indexes and locally indexed images are only useful
+together if both cut at the same offsets, so the boundaries for a fixed
+input are pinned here: a change to the chunker that moves them also
+needs a new ``CHUNK_INDEX_VERSION``.
+"""
+
+from __future__ import annotations
+
+import hashlib
+import sys
+from pathlib import Path
+
+import pytest
+
+# cdc depends on numpy alone; load it without the rest of the daemon.
+sys.path.insert(0, str(Path(__file__).resolve().parents[2] / "src" / "daemon"))
+from cdc import (  # noqa: E402
+    CHUNK_INDEX_VERSION,
+    CHUNK_MAX_SIZE,
+    CHUNK_MIN_SIZE,
+    chunk_boundaries,
+)
+
+_DATA = hashlib.shake_256(b"kapsule cdc test vector").digest(4 * 1024 * 1024)
+
+_PINNED_BOUNDARIES = [
+    444349,
+    899609,
+    1084213,
+    1389419,
+    1710900,
+    2030688,
+    2601516,
+    2699271,
+    2872529,
+    3083637,
+    3692234,
+    3931250,
+    3998055,
+    4194304,
+]
+
+
+def test_boundaries_are_pinned() -> None:
+    assert CHUNK_INDEX_VERSION == 1
+    assert chunk_boundaries(_DATA) == _PINNED_BOUNDARIES
+
+
+@pytest.mark.parametrize("block_size", [4097, 64 * 1024, 16 * 1024 * 1024])
+def test_boundaries_do_not_depend_on_block_size(block_size: int) -> None:
+    assert chunk_boundaries(_DATA, block_size=block_size) == _PINNED_BOUNDARIES
+
+
+def test_chunk_sizes_stay_within_limits() -> None:
+    starts = [0, *_PINNED_BOUNDARIES[:-1]]
+    sizes = [end - start for start, end in zip(starts, _PINNED_BOUNDARIES, strict=True)]
+    assert all(size <= CHUNK_MAX_SIZE for size in sizes)
+    assert all(size >= CHUNK_MIN_SIZE for size in sizes[:-1])
+
+
+def test_insertion_only_changes_nearby_chunks() -> None:
+    edited = _DATA[:1000] + b"kapsule" + _DATA[1000:]
+    shifted = [end - len(b"kapsule") for end in chunk_boundaries(edited)]
+    assert shifted[1:] == _PINNED_BOUNDARIES[1:]
+
+
+@pytest.mark.parametrize("size", [0, 1, 63, CHUNK_MIN_SIZE])
+def test_short_inputs(size: int) -> None:
+    assert chunk_boundaries(_DATA[:size]) == ([size] if size else [])